@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <sofa/pbrpc/pbrpc.h>
 #include <glog/logging.h>
 #include <gflags/gflags.h>
@@ -9,6 +10,8 @@
 
 DEFINE_string(server_addr, "127.0.0.1:10000","请求的搜索服务器的地址");
 DEFINE_string(template_path,"wwwroot/template/search_page.html","模板文件的路径");
+DEFINE_int32(timeout_ms, 3000, "请求的超时时间(毫秒)，同时告诉服务器，服务器据此计算截止时间");
+DEFINE_int32(max_result_window, 1000, "最多可以翻到的结果数，和服务器保持一致，超过之后不再显示下一页");
 
 namespace doc_client
 {
@@ -65,14 +68,24 @@ void PackageRequest(Request* req)
     // 这里sid的生成先不考虑
     req->set_sid(0);
     req->set_timestamp(common::TimeUtil::TimeStamp());
+    //超过这个时间之后客户端不再等待响应，服务器也就不用再处理了
+    req->set_timeout_ms(fLI::FLAGS_timeout_ms);
+    //服务器据此把请求在队列中排队的时间也算进去
+    req->set_sent_ms(common::TimeUtil::TimeStampMS());
 
     //这里的查询词要从环境变量中获取
     char buf[1024] = {0};
     GetQueryString(buf);
-    //现在buf中就有query=hah字符串了
+    //现在buf中就有query=hah&offset=10字符串了，offset可以没有
     char query[1024] = {0};
-    sscanf(buf, "query=%s", query);
+    sscanf(buf, "query=%[^&]", query);
     req->set_query(query);
+    //翻页，每页的结果数使用服务器的默认值
+    const char* offset = strstr(buf, "&offset=");
+    if(offset != NULL)
+    {
+        req->set_offset(atoi(offset + strlen("&offset=")));
+    }
 }
 
 void Search(const Request& req, Response* resp)
@@ -90,7 +103,7 @@ void Search(const Request& req, Response* resp)
     doc_server_proto::DocServerAPI_Stub stub(&channel);
     //4. 再定义一个ctrl对象，用来网络控制的对象
     RpcController ctrl;
-    ctrl.SetTimeout(3000);//3000毫秒
+    ctrl.SetTimeout(fLI::FLAGS_timeout_ms);
     //5. 远程调用服务器端的Search函数。这里在客户端
     //   本地调用就相当于调用到远端服务器的函数了
     stub.Search(&ctrl, &req, resp, NULL);
@@ -106,12 +119,33 @@ void Search(const Request& req, Response* resp)
     }
 }
 
-void ParseResponse(const Response& resp)
+//翻页的链接，offset 为要翻到的那一页的起始位置
+//req 中的查询词就是 QUERY_STRING 中的原样(已经做过 url 编码)，可以直接放到链接里
+void AddPageLink(const Request& req, const char* name, uint32_t offset, ctemplate::TemplateDictionary* dict)
+{
+    ctemplate::TemplateDictionary* link_dict = dict->AddSectionDictionary(name);
+    link_dict->SetValue("query", req.query());
+    link_dict->SetIntValue("offset", offset);
+}
+
+void ParseResponse(const Request& req, const Response& resp)
 {
     // 返回的响应的结果是HTML
     // 此处使用ctemplate完成页面构造
     // 目的是为了HTML所描述的界面和cpp的逻辑拆分开
     ctemplate::TemplateDictionary dict("SearchPage");
+    dict.SetIntValue("total_hits", resp.total_hits());
+    //不是第一页时有上一页，这一页是满的并且后面还有可以翻到的结果时有下一页，
+    //服务器最多只返回前 max_result_window 个结果，total_hits 通常比它大
+    if(req.offset() > 0)
+    {
+        AddPageLink(req, "prev_page", req.offset() > req.num() ? req.offset() - req.num() : 0, &dict);
+    }
+    uint64_t last = std::min<uint64_t>(resp.total_hits(), std::max(fLI::FLAGS_max_result_window, 0));
+    if((uint32_t)resp.item_size() >= req.num() && (uint64_t)req.offset() + req.num() < last)
+    {
+        AddPageLink(req, "next_page", req.offset() + req.num(), &dict);
+    }
     for(int i = 0; i < resp.item_size(); ++i)
     {
         ctemplate::TemplateDictionary* table_dict = dict.AddSectionDictionary("item");
@@ -149,10 +183,7 @@ void CallServer()
     //3. 解析响应并输出结果，由于这个客户端
     //   就是cgi程序，这里输出就相当于经过http
     //   服务器返回给浏览器
-    ParseResponse(resp);
-    std::cout << resp.item(0).title() << std::endl;
-    std::cout << resp.item(0).jump_url() << std::endl;
-    std::cout << resp.item_size() << std::endl;
+    ParseResponse(req, resp);
     fprintf(stderr, "ParseResponse Over!!!\n");
     //std::cout << "hahahahhahahahha" << std::endl;
     return;
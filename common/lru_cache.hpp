@@ -0,0 +1,143 @@
+#pragma once
+#include <list>
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <stdint.h>
+#include "util.hpp"
+
+
+namespace common
+{
+
+//分片的 LRU 缓存，多线程共享
+//key 按照哈希值分到不同的分片，每个分片一把锁，各自按照最近使用的顺序淘汰，
+//不同分片的读写互不影响，分片数比线程数多时线程之间基本没有锁竞争
+//元素可以有有效时间，过期的元素在被访问到的时候删除
+//Value 在锁内拷贝，比较大的值应该用 shared_ptr 保存
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ShardedLruCache
+{
+public:
+    //capacity 为所有分片的总容量，为0时不缓存任何元素
+    //ttl_ms 为元素的有效时间(毫秒)，为0表示不过期
+    ShardedLruCache(size_t capacity, size_t shard_num, int64_t ttl_ms)
+        : shard_num_(shard_num == 0 ? 1 : shard_num)
+        , shard_capacity_((capacity + shard_num_ - 1) / shard_num_)
+        , ttl_ms_(ttl_ms)
+        , shards_(new Shard[shard_num_])
+        , hits_(0)
+        , misses_(0)
+    {}
+
+    //不存在或者已经过期时返回 false
+    bool Get(const Key& key, Value* value)
+    {
+        Shard& shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if(it == shard.index.end())
+        {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if(ttl_ms_ > 0 && it->second->expire_ms <= TimeUtil::TimeStampMS())
+        {
+            shard.lru.erase(it->second);
+            shard.index.erase(it);
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        //移到表头
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        *value = it->second->value;
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    //已经存在时覆盖旧的值，并重新计算有效时间
+    void Put(const Key& key, const Value& value)
+    {
+        if(shard_capacity_ == 0)
+        {
+            return;
+        }
+        int64_t expire_ms = ttl_ms_ > 0 ? TimeUtil::TimeStampMS() + ttl_ms_ : 0;
+        Shard& shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if(it != shard.index.end())
+        {
+            it->second->value = value;
+            it->second->expire_ms = expire_ms;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            return;
+        }
+        Entry entry = {key, value, expire_ms};
+        shard.lru.push_front(entry);
+        shard.index[key] = shard.lru.begin();
+        //淘汰最久没有使用的元素
+        while(shard.lru.size() > shard_capacity_)
+        {
+            shard.index.erase(shard.lru.back().key);
+            shard.lru.pop_back();
+        }
+    }
+
+    void Clear()
+    {
+        for(size_t i = 0; i < shard_num_; ++i)
+        {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            shards_[i].lru.clear();
+            shards_[i].index.clear();
+        }
+    }
+
+    //命中和没有命中的次数
+    uint64_t hits() const
+    {
+        return hits_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t misses() const
+    {
+        return misses_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Entry
+    {
+        Key key;
+        Value value;
+        int64_t expire_ms;
+    };
+    typedef std::list<Entry> LruList;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        LruList lru; //表头是最近使用的元素
+        std::unordered_map<Key, typename LruList::iterator, Hash> index;
+    };
+
+    Shard& GetShard(const Key& key)
+    {
+        return shards_[hash_(key) % shard_num_];
+    }
+
+    size_t shard_num_;
+    size_t shard_capacity_;
+    int64_t ttl_ms_;
+    std::unique_ptr<Shard[]> shards_;
+    Hash hash_;
+    std::atomic<uint64_t> hits_;
+    std::atomic<uint64_t> misses_;
+
+    ShardedLruCache(const ShardedLruCache&);
+    ShardedLruCache& operator=(const ShardedLruCache&);
+};
+
+} //end common
@@ -0,0 +1,85 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+
+namespace common
+{
+
+//固定线程数的线程池，任务按照提交的顺序执行
+//析构时等已经提交的任务都执行完再退出
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t thread_num)
+        : stop_(false)
+    {
+        for(size_t i = 0; i < thread_num; ++i)
+        {
+            threads_.push_back(std::thread(&ThreadPool::Run, this));
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+        for(auto& thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    void Submit(const std::function<void()>& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(task);
+        }
+        cond_.notify_one();
+    }
+
+    size_t thread_num() const
+    {
+        return threads_.size();
+    }
+
+private:
+    void Run()
+    {
+        while(true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this]{ return stop_ || !tasks_.empty(); });
+                if(tasks_.empty())
+                {
+                    //stop_ 并且任务都执行完了
+                    return;
+                }
+                task.swap(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> threads_;
+    bool stop_;
+
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+};
+
+} //end common
@@ -1,15 +1,131 @@
 #pragma once
 #include <string>
+#include <cstring>
 #include <fstream>
 #include <vector>
+#include <deque>
 #include <unordered_set>
+#include <stdint.h>
 #include <boost/algorithm/string.hpp>
 #include <sys/time.h>
+#include <stdlib.h>
+#include <unistd.h>
 
 
 namespace common
 {
 
+//字符串的只读视图，只保存指针和长度，不持有数据(类似 C++17 的 string_view)
+//数据的生命周期由调用者保证
+class StringPiece
+{
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    StringPiece()
+        : data_(NULL)
+        , size_(0)
+    {}
+
+    StringPiece(const char* data, size_t size)
+        : data_(data)
+        , size_(size)
+    {}
+
+    StringPiece(const std::string& str)
+        : data_(str.data())
+        , size_(str.size())
+    {}
+
+    StringPiece(const char* str)
+        : data_(str)
+        , size_(strlen(str))
+    {}
+
+    const char* data() const
+    {
+        return data_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    char operator[](size_t i) const
+    {
+        return data_[i];
+    }
+
+    StringPiece substr(size_t pos, size_t n = npos) const
+    {
+        if(pos > size_)
+        {
+            pos = size_;
+        }
+        if(n > size_ - pos)
+        {
+            n = size_ - pos;
+        }
+        return StringPiece(data_ + pos, n);
+    }
+
+    std::string ToString() const
+    {
+        return std::string(data_, size_);
+    }
+
+    int compare(const StringPiece& other) const
+    {
+        size_t len = size_ < other.size_ ? size_ : other.size_;
+        int ret = len == 0 ? 0 : memcmp(data_, other.data_, len);
+        if(ret != 0)
+        {
+            return ret;
+        }
+        return size_ < other.size_ ? -1 : (size_ > other.size_ ? 1 : 0);
+    }
+
+    bool operator==(const StringPiece& other) const
+    {
+        return size_ == other.size_ && compare(other) == 0;
+    }
+
+    bool operator!=(const StringPiece& other) const
+    {
+        return !(*this == other);
+    }
+
+    bool operator<(const StringPiece& other) const
+    {
+        return compare(other) < 0;
+    }
+
+private:
+    const char* data_;
+    size_t size_;
+};
+
+//StringPiece 作为哈希表的 key 时使用的哈希函数(FNV-1a)
+struct StringPieceHash
+{
+    size_t operator()(const StringPiece& str) const
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        for(size_t i = 0; i < str.size(); ++i)
+        {
+            hash ^= (uint8_t)str[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+};
+
 class StringUtil
 {
 public:
@@ -22,17 +138,23 @@ public:
         boost::split(*output, input, boost::is_any_of(split_char), boost::token_compress_off);
     }
 
-    static int32_t FindSentenceBeg(const std::string& content, int32_t first_pos)
+    //content[i] 是不是句子的结束标志，不能用.作为句子
+    //的结束标志，因为可能存在以下情况
+    //s.begin()，但是如果是.后面还跟着空格就表示
+    //句子结束了
+    static bool IsSentenceEnd(const StringPiece& content, size_t i)
+    {
+        return content[i] == ';' || content[i] == ',' ||
+               content[i] == '?' || content[i] == '!' ||
+               (content[i] == '.' && i + 1 < content.size() && content[i+1] == ' ');
+    }
+
+    static int32_t FindSentenceBeg(const StringPiece& content, int32_t first_pos)
     {
-        //从first_pos位置超前找，不能用.作为句子
-        //的结束标志，因为可能存在以下情况
-        //s.begin()，但是如果是.后面还跟着空格就表示
-        //句子结束了
+        //从first_pos位置超前找
         for(int32_t i = first_pos; i >= 0 ; --i)
         {
-            if(content[i] == ';' || content[i] == ',' ||
-               content[i] == '?' || content[i] == '!' ||
-               (content[i] == '.' && content[i+1] == ' '))
+            if(IsSentenceEnd(content, i))
             {
                 return i + 1;
             }
@@ -40,6 +162,50 @@ public:
         //如果没有找到结束标志，表示这是句子第一句话
         return 0;
     }
+
+    //正文中除了第一句以外每个句子的起始位置(结束标志的下一个字节)，升序
+    //first_pos 所在句子的起始位置就是最后一个 <= first_pos + 1 的起始位置，没有时为0，
+    //和 FindSentenceBeg 的结果一样
+    static void SentenceStarts(const StringPiece& content, std::vector<uint32_t>* starts)
+    {
+        starts->clear();
+        for(size_t i = 0; i < content.size(); ++i)
+        {
+            if(IsSentenceEnd(content, i))
+            {
+                starts->push_back(i + 1);
+            }
+        }
+    }
+
+    //HTML 转义，一遍扫描直接追加到 output 后面
+    static void AppendEscapeHtml(const StringPiece& input, std::string* output)
+    {
+        size_t beg = 0;
+        for(size_t i = 0; i < input.size(); ++i)
+        {
+            const char* escape = NULL;
+            switch(input[i])
+            {
+            case '&': escape = "&amp;"; break;
+            case '"': escape = "&quot;"; break;
+            case '<': escape = "&lt;"; break;
+            case '>': escape = "&gt;"; break;
+            default: continue;
+            }
+            output->append(input.data() + beg, i - beg);
+            output->append(escape);
+            beg = i + 1;
+        }
+        output->append(input.data() + beg, input.size() - beg);
+    }
+
+    //文档按照 jump_url 分到 shard_num 个分片中的哪一个，同一个文档总是在同一个分片中
+    //构建分片索引和聚合服务器转发新增、删除文档的请求都用它
+    static uint32_t ShardOf(const StringPiece& jump_url, uint32_t shard_num)
+    {
+        return StringPieceHash()(jump_url) % shard_num;
+    }
 };
 
 class DicUtil
@@ -60,19 +226,23 @@ public:
         std::string line;
         while(std::getline(file, line))
         {
-            set_.insert(line);
+            //deque 插入元素时已有的元素不会移动，set_ 中的 key 可以直接指向它们
+            words_.push_back(line);
+            set_.insert(words_.back());
         }
 
         return true;
     }
 
-    bool Find(const std::string& key)const
+    //查找时不需要构造 std::string
+    bool Find(const StringPiece& key)const
     {
         return set_.find(key) != set_.end();
     }
 
 private:
-    std::unordered_set<std::string> set_;
+    std::deque<std::string> words_;
+    std::unordered_set<StringPiece, StringPieceHash> set_;
 };
 
 class FileUtil
@@ -114,6 +284,66 @@ public:
     }
 };
 
+//构建时使用的临时目录，名字由 mkdtemp 生成，同时进行的多个构建各自使用自己的目录，临时文件不会互相覆盖
+//析构时删除目录中用 NewFile 分配的文件和目录本身，构建中途失败返回时也会清理
+class TmpDir
+{
+public:
+    TmpDir()
+    {}
+
+    ~TmpDir()
+    {
+        Remove();
+    }
+
+    //在 parent 下创建一个名字以 prefix 开头的目录
+    bool Create(const std::string& parent, const std::string& prefix)
+    {
+        Remove();
+        std::string path = parent + "/" + prefix + "XXXXXX";
+        if(::mkdtemp(&path[0]) == NULL)
+        {
+            return false;
+        }
+        path_ = path;
+        return true;
+    }
+
+    const std::string& path() const
+    {
+        return path_;
+    }
+
+    //目录中一个文件的路径，这个文件在 Remove 的时候删除
+    std::string NewFile(const std::string& name)
+    {
+        files_.push_back(path_ + "/" + name);
+        return files_.back();
+    }
+
+    void Remove()
+    {
+        for(const auto& file : files_)
+        {
+            ::unlink(file.c_str());
+        }
+        files_.clear();
+        if(!path_.empty())
+        {
+            ::rmdir(path_.c_str());
+            path_.clear();
+        }
+    }
+
+private:
+    std::string path_;
+    std::vector<std::string> files_;
+
+    TmpDir(const TmpDir&);
+    TmpDir& operator=(const TmpDir&);
+};
+
 class TimeUtil
 {
 public:
@@ -140,6 +370,19 @@ public:
         ::gettimeofday(&tv, NULL);
         return tv.tv_sec * 1000 * 1000 + tv.tv_usec;
     }
+
+    //估计收到请求的时间(毫秒时间戳)，RPC 框架先把请求放到队列中，处理函数开始执行时已经排过队了，
+    //用发送方的时间戳 sent_ms 估计，max_skew_ms 为两台机器的时钟误差的上限，结果不晚于现在
+    //sent_ms 为 0 或者 max_skew_ms 小于 0 时返回现在
+    static int64_t EstimateReceivedMS(int64_t sent_ms, int64_t max_skew_ms)
+    {
+        int64_t now_ms = TimeStampMS();
+        if(sent_ms <= 0 || max_skew_ms < 0 || sent_ms + max_skew_ms > now_ms)
+        {
+            return now_ms;
+        }
+        return sent_ms + max_skew_ms;
+    }
 };
 
 } //end common
@@ -0,0 +1,50 @@
+#include "bm25.h"
+#include <cmath>
+#include <algorithm>
+#include <gflags/gflags.h>
+
+DEFINE_double(bm25_k1, 1.2, "BM25 的 k1 参数，词频的饱和速度");
+DEFINE_double(bm25_title_b, 0.75, "BM25 标题的长度归一化参数 b");
+DEFINE_double(bm25_content_b, 0.75, "BM25 正文的长度归一化参数 b");
+DEFINE_double(bm25_title_weight, 3.0, "BM25F 中标题的权重");
+DEFINE_double(bm25_content_weight, 1.0, "BM25F 中正文的权重");
+
+namespace doc_index
+{
+
+Bm25Scorer::Bm25Scorer()
+    : idf_(0)
+    , k1_(1)
+    , title_weight_(0)
+    , title_norm0_(1)
+    , title_norm1_(0)
+    , content_weight_(0)
+    , content_norm0_(1)
+    , content_norm1_(0)
+{
+    min_length_.title_len = 0;
+    min_length_.content_len = 0;
+}
+
+Bm25Scorer::Bm25Scorer(const Bm25Stats& stats, uint64_t df)
+    : k1_(fLD::FLAGS_bm25_k1)
+    , title_weight_(fLD::FLAGS_bm25_title_weight)
+    , content_weight_(fLD::FLAGS_bm25_content_weight)
+    , min_length_(stats.min_length)
+{
+    //保证 idf 不会是负数
+    double doc_cnt = std::max<double>(stats.doc_cnt, df);
+    double idf = std::log(1.0 + (doc_cnt - df + 0.5) / (df + 0.5));
+    idf_ = idf * (fLD::FLAGS_bm25_k1 + 1) * kScoreScale;
+
+    //没有平均长度(还没有加载索引文件)时不做长度归一化，
+    //b 不能为1，否则长度为0的文档 norm 为0
+    double title_b = stats.avg_title_len > 0 ? std::min(fLD::FLAGS_bm25_title_b, 0.99) : 0;
+    title_norm0_ = 1 - title_b;
+    title_norm1_ = stats.avg_title_len > 0 ? title_b / stats.avg_title_len : 0;
+    double content_b = stats.avg_content_len > 0 ? std::min(fLD::FLAGS_bm25_content_b, 0.99) : 0;
+    content_norm0_ = 1 - content_b;
+    content_norm1_ = stats.avg_content_len > 0 ? content_b / stats.avg_content_len : 0;
+}
+
+} //end doc_index
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "index_file.h"
+
+
+namespace doc_index
+{
+
+//得分乘以 kScoreScale 之后取整，累加的时候是整数运算，
+//不管按照什么顺序累加(WAND 和按拉链累加)，同一个文档的得分都完全一样
+static const float kScoreScale = 1000.0f;
+
+//BM25F 打分需要的统计信息，都是构建索引的时候统计好保存在索引文件中的，查询时不需要再统计
+struct Bm25Stats
+{
+    uint64_t doc_cnt;       //文档总数
+    double avg_title_len;   //标题的平均长度
+    double avg_content_len; //正文的平均长度
+    DocLength min_length;   //最短的标题和正文长度，估算得分上限时使用
+};
+
+//一个查询词的 BM25F 打分，标题和正文两个域：
+//  tf = title_weight * title_tf / title_norm + content_weight * content_tf / content_norm
+//  norm = 1 - b + b * len / avg_len
+//  score = idf * (k1 + 1) * tf / (k1 + tf)
+//  idf = log(1 + (N - df + 0.5) / (df + 0.5))
+//df 就是拉链的长度，N 为文档总数，每个文档的长度在文档长度表中，
+//和查询词相关的部分在构造的时候算好，每个文档只需要几次乘法和一次除法
+class Bm25Scorer
+{
+public:
+    //所有文档得分都为0
+    Bm25Scorer();
+
+    Bm25Scorer(const Bm25Stats& stats, uint64_t df);
+
+    //一个文档的得分
+    //score = idf * (k1 + 1) * (1 - k1 / (k1 + tf))，每一步都是单调的，
+    //词频越大、文档越短，算出来的得分一定不会更小
+    int32_t Score(uint32_t title_tf, uint32_t content_tf, const DocLength& length) const
+    {
+        float tf = title_tf * title_weight_ / (title_norm0_ + title_norm1_ * length.title_len)
+                   + content_tf * content_weight_ / (content_norm0_ + content_norm1_ * length.content_len);
+        return (int32_t)(idf_ * (1.0f - k1_ / (k1_ + tf)) + 0.5f);
+    }
+
+    //一组文档的得分，循环中没有分支和函数调用，编译器可以自动向量化
+    template <typename TfType>
+    void Score(const TfType* title_tf, const TfType* content_tf, const DocLength* lengths,
+               size_t n, int32_t* scores) const
+    {
+        for(size_t i = 0; i < n; ++i)
+        {
+            scores[i] = Score(title_tf[i], content_tf[i], lengths[i]);
+        }
+    }
+
+    //词频不超过 max_title_tf，max_content_tf 的文档的得分上限，WAND 使用
+    //按照最短的文档估算，多加1防止浮点运算的误差
+    int32_t MaxScore(uint32_t max_title_tf, uint32_t max_content_tf) const
+    {
+        return Score(max_title_tf, max_content_tf, min_length_) + 1;
+    }
+
+private:
+    float idf_; //idf * (k1 + 1) * kScoreScale
+    float k1_;
+    float title_weight_;
+    float title_norm0_; //1 - b
+    float title_norm1_; //b / avg_len
+    float content_weight_;
+    float content_norm0_;
+    float content_norm1_;
+    DocLength min_length_;
+};
+
+} //end doc_index
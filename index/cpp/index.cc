@@ -1,4 +1,14 @@
 #include <fstream>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+#include <queue>
+#include <memory>
+#include <limits>
+#include <cstdio>
+#include <cstring>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+#include <google/protobuf/util/delimited_message_util.h>
 #include <base/base.h>
 #include "index.h"
 
@@ -8,25 +18,40 @@ DEFINE_string(hmm_path, "../../third_part/data/jieba_dict/hmm_model.utf8", "hmm
 DEFINE_string(user_dict_path, "../../third_part/data/jieba_dict/user.dict.utf8", "用户自定制词典路径");
 DEFINE_string(idf_path, "../../third_part/data/jieba_dict/idf.utf8", "idf 字典路径");
 DEFINE_string(stop_word_path, "../../third_part/data/jieba_dict/stop_words.utf8", "暂停词字典路径");
+DEFINE_int32(realtime_max_doc_cnt, 100000, "实时段最多能容纳的文档数，超出之后需要重新构建索引");
+DEFINE_int32(doc_cache_block_cnt, 256, "缓存的解压之后的正排块的个数，每块大约32KB");
+DEFINE_bool(index_positions, true, "构建位置索引(每个词在文档中出现的位置)，短语查询需要");
+DEFINE_int32(cut_cache_size, 100000, "查询分词结果缓存的条数，0 表示不缓存");
+DEFINE_int32(cut_cache_shard_num, 16, "查询分词结果缓存的分片数");
 
 namespace doc_index
 {
     
 Index* Index::inst_ = NULL;
+thread_local IndexSnapshot* Index::pinned_ = NULL;
 
 Index::Index()
-    : jieba_(fLS::FLAGS_dict_path,
+    : snapshot_(new IndexSnapshot())
+    , load_cnt_(0)
+    , jieba_(fLS::FLAGS_dict_path,
              fLS::FLAGS_hmm_path,
              fLS::FLAGS_user_dict_path,
              fLS::FLAGS_idf_path,
              fLS::FLAGS_stop_word_path)
+    , cut_cache_(std::max(fLI::FLAGS_cut_cache_size, 0), std::max(fLI::FLAGS_cut_cache_shard_num, 1), 0)
+    , version_(0)
     {
         CHECK(stop_word_dict_.Load(fLS::FLAGS_stop_word_path));
     }
 
 //从raw_input 文件当中读数据，在内存中构建索引结构
-bool Index::Build(const std::string& input_path)
+bool Index::Build(const std::string& input_path, int thread_num)
 {
+    if(thread_num > 1)
+    {
+        return BuildParallel(input_path, thread_num);
+    }
+
     LOG(INFO) << "Index Build";
     //1.按行读取文件内容，每一行都是一个文件
     std::ifstream file(input_path.c_str());
@@ -36,23 +61,383 @@ bool Index::Build(const std::string& input_path)
     {
         //2.把一行数据（代表一个正文）制作成一个DocInfo(正排索引数组的元素类型)
         //  此处获取到的doc_info 是为了接下来制作倒排方便
-        const DocInfo* doc_info = BuildForward(line);
+        //  文档id就是它在正排数组中的下标
+        forward_index_.push_back(DocInfo());
+        DocInfo* doc_info = &forward_index_.back();
         //如果构建失败，立刻终止进程
-        CHECK(doc_info != NULL);
+        CHECK(BuildForward(line, forward_index_.size() - 1, &jieba_, doc_info));
         //3. 更新倒排信息
         //   此函数的输出结果，直接放到Index::inverted_index_中
-        BuildInverted(*doc_info);
+        BuildInverted(*doc_info, &inverted_index_);
     }
 
-    //4. 处理完所有文档之后，针对所有的倒排拉链进行排序
-    //   key-value中的value进行排序，按照权重降序排序
-    SortInverted();
+    //文档是按照id的顺序处理的，所以每个倒排拉链天然就是按照文档id升序排列的，
+    //不需要再排序
     file.close();
     LOG(INFO) << "Index Build Done!!!";
     return true;
 }
 
-const DocInfo* Index::BuildForward(const std::string& line)
+//多线程构建索引
+//先把所有行读到内存中，再交给 BuildLines 多线程处理
+bool Index::BuildParallel(const std::string& input_path, int thread_num)
+{
+    LOG(INFO) << "Index Build, thread_num=" << thread_num;
+    std::ifstream file(input_path.c_str());
+    CHECK(file.is_open()) << "input_path:" << input_path;
+    std::vector<std::string> lines;
+    std::string line;
+    while(std::getline(file, line))
+    {
+        lines.push_back(line);
+    }
+    file.close();
+
+    BuildLines(lines, forward_index_.size(), thread_num);
+    LOG(INFO) << "Index Build Done!!!";
+    return true;
+}
+
+//增量构建，在已经加载好的索引(Load)的基础上追加 input_path 中的新文档
+//新文档的id接在已加载的文档之后分配，只有新文档需要分词。
+//新文档的倒排构建在 inverted_index_ 中，Save 的时候再和已加载的拉链合并
+bool Index::BuildIncremental(const std::string& input_path, int thread_num)
+{
+    SnapshotRef snapshot(this);
+    LOG(INFO) << "Index Build Incremental, base doc_cnt=" << snapshot->reader.doc_cnt();
+    std::ifstream file(input_path.c_str());
+    CHECK(file.is_open()) << "input_path:" << input_path;
+    std::vector<std::string> lines;
+    std::string line;
+    while(std::getline(file, line))
+    {
+        lines.push_back(line);
+    }
+    file.close();
+
+    BuildLines(lines, snapshot->reader.doc_cnt() + forward_index_.size(), thread_num);
+    LOG(INFO) << "Index Build Incremental Done!!! add doc_cnt=" << lines.size();
+    return true;
+}
+
+//把一批行构建成正排追加到 forward_index_ 的末尾，倒排合并到 inverted_index_ 中
+//这批文档的id从 first_doc_id 开始依次递增
+//多线程时把这批行按照顺序切成 thread_num 段连续的区间，每个线程处理一段，
+//每个线程有自己的 jieba 对象和自己的倒排分片，互相之间不需要加锁。
+//最后按照区间的顺序把各个分片合并到 inverted_index_ 中，这样每个倒排拉链
+//中文档的先后顺序和单线程构建时完全一样，排序和保存的结果也就完全一样
+void Index::BuildLines(const std::vector<std::string>& lines, uint64_t first_doc_id, int thread_num)
+{
+    //1. 提前把正排数组开好，每个线程只写自己区间内的元素
+    size_t base = forward_index_.size();
+    forward_index_.resize(base + lines.size());
+    DocInfo* docs = forward_index_.data() + base;
+    if(thread_num <= 1)
+    {
+        BuildShard(0, lines, 0, lines.size(), first_doc_id, docs, &inverted_index_);
+        return;
+    }
+
+    //2. 每个线程处理一段连续的行，生成自己的倒排分片
+    if(shard_jieba_.size() < (size_t)thread_num)
+    {
+        shard_jieba_.resize(thread_num);
+    }
+    std::vector<InvertedIndex> shards(thread_num);
+    std::vector<std::thread> workers;
+    size_t step = (lines.size() + thread_num - 1) / thread_num;
+    for(int i = 0; i < thread_num; ++i)
+    {
+        size_t beg = std::min(lines.size(), i * step);
+        size_t end = std::min(lines.size(), beg + step);
+        workers.push_back(std::thread(&Index::BuildShard, this, i, std::cref(lines),
+                                      beg, end, first_doc_id, docs, &shards[i]));
+    }
+    for(auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    //3. 按照分片顺序合并
+    MergeShards(&shards);
+}
+
+//处理 [beg, end) 区间的行，第 i 行的文档id为 first_doc_id + i，结果写到 docs[i] 中
+void Index::BuildShard(int shard_id, const std::vector<std::string>& lines, size_t beg, size_t end,
+                       uint64_t first_doc_id, DocInfo* docs, InvertedIndex* shard)
+{
+    //cppjieba 对象每个线程单独一个，不和其他线程共享
+    //0 号线程直接使用 jieba_，其他线程第一次用到的时候在自己的线程中创建
+    cppjieba::Jieba* jieba = &jieba_;
+    if(shard_id > 0)
+    {
+        if(!shard_jieba_[shard_id])
+        {
+            shard_jieba_[shard_id].reset(new cppjieba::Jieba(fLS::FLAGS_dict_path,
+                                                             fLS::FLAGS_hmm_path,
+                                                             fLS::FLAGS_user_dict_path,
+                                                             fLS::FLAGS_idf_path,
+                                                             fLS::FLAGS_stop_word_path));
+        }
+        jieba = shard_jieba_[shard_id].get();
+    }
+    for(size_t i = beg; i < end; ++i)
+    {
+        DocInfo* doc_info = &docs[i];
+        CHECK(BuildForward(lines[i], first_doc_id + i, jieba, doc_info));
+        BuildInverted(*doc_info, shard);
+    }
+}
+
+//把各个线程的倒排分片合并到 inverted_index_ 中
+//分片必须按照文档id从小到大的顺序传入
+void Index::MergeShards(std::vector<InvertedIndex>* shards)
+{
+    for(auto& shard : *shards)
+    {
+        //每个分片有自己的关键词id，按照关键词映射到 inverted_index_ 的id上
+        for(uint32_t term_id = 0; term_id < shard.size(); ++term_id)
+        {
+            InvertedList& inverted_list = inverted_index_[shard.dict.term(term_id)];
+            if(inverted_list.empty())
+            {
+                //这个词第一次出现，直接把整个拉链交换过来，不用拷贝
+                inverted_list.swap(shard.lists[term_id]);
+                continue;
+            }
+            inverted_list.append(shard.lists[term_id]);
+        }
+        //合并完一个分片就释放掉，降低内存峰值
+        InvertedIndex().swap(shard);
+    }
+}
+
+//外部排序时的一路 run，按照关键词从小到大的顺序依次读取其中的 KwdInfo
+struct InvertedRun
+{
+    std::ifstream file;
+    std::unique_ptr<google::protobuf::io::IstreamInputStream> input;
+    doc_index_proto::KwdInfo kwd_info;
+
+    bool Open(const std::string& path)
+    {
+        file.open(path.c_str(), std::ios::binary);
+        if(!file.is_open())
+        {
+            return false;
+        }
+        input.reset(new google::protobuf::io::IstreamInputStream(&file));
+        return true;
+    }
+
+    //读取下一个 KwdInfo，读到文件末尾返回 false
+    bool Next()
+    {
+        kwd_info.Clear();
+        return google::protobuf::util::ParseDelimitedFromZeroCopyStream(&kwd_info, input.get(), NULL);
+    }
+};
+
+//内存受限的构建方式(外部排序)，构建完直接写出索引文件，不需要再调用 Save
+//a）正排构建出来之后直接按照文档id的顺序写到索引文件中，不在内存中保留
+//b）倒排估算的内存占用超过 mem_budget 之后，按照关键词排好序写到一个临时文件中
+//   (称为一路 run)，然后清空内存中的倒排继续构建
+//c）所有文档处理完之后，对所有的 run 做多路归并，相同关键词的拉链按照 run 的顺序
+//   (也就是文档id的顺序)拼起来，排序之后写到索引文件的末尾
+//得到的索引文件和 Build + Save 得到的完全一样
+//run 放在 tmp_dir 下这次构建自己的临时目录中，同时进行的构建不会互相覆盖，
+//构建结束(包括失败返回)时临时目录和没有 rename 的索引文件都会删掉
+bool Index::BuildExternal(const std::string& input_path, const std::string& output_path,
+                          int thread_num, size_t mem_budget, const std::string& tmp_dir)
+{
+    LOG(INFO) << "Index Build External, mem_budget=" << mem_budget;
+    std::ifstream file(input_path.c_str());
+    CHECK(file.is_open()) << "input_path:" << input_path;
+    common::TmpDir run_dir;
+    if(!run_dir.Create(tmp_dir, "index_runs_"))
+    {
+        PLOG(ERROR) << "BuildExternal create tmp dir failed! tmp_dir:" << tmp_dir;
+        return false;
+    }
+    //和 Save 一样先写临时文件再 rename
+    std::string tmp_path = output_path + ".tmp";
+    std::ofstream index_file(tmp_path.c_str(), std::ios::binary);
+    CHECK(index_file.is_open()) << "output_path:" << tmp_path;
+    std::vector<std::string> run_paths;
+    bool ok = true;
+    {
+        IndexWriter writer(&index_file);
+
+        //1. 每次读一批行进行构建
+        //   一行原始数据构建成 DocInfo 之后会膨胀好几倍(分词结果)，
+        //   所以一批行的总大小只占内存预算的一小部分
+        size_t batch_size = std::max<size_t>(mem_budget / 8, 1);
+        uint64_t doc_cnt = 0;
+        std::vector<std::string> lines;
+        std::string line;
+        bool has_more = true;
+        while(ok && has_more)
+        {
+            lines.clear();
+            size_t lines_size = 0;
+            while(lines_size < batch_size && (has_more = (bool)std::getline(file, line)))
+            {
+                lines_size += line.size();
+                lines.push_back(line);
+            }
+            if(lines.empty())
+            {
+                break;
+            }
+            BuildLines(lines, doc_cnt, thread_num);
+            doc_cnt += lines.size();
+
+            //2. 正排直接写到索引文件中
+            DocView doc;
+            for(const auto& doc_info : forward_index_)
+            {
+                ToDocView(doc_info, &doc);
+                writer.AddDoc(doc);
+            }
+            ForwardIndex().swap(forward_index_);
+
+            //3. 倒排超出内存预算之后写一路 run
+            if(EstimateInvertedSize() >= mem_budget)
+            {
+                ok = SpillRun(&run_dir, &run_paths);
+            }
+        }
+        if(ok && !inverted_index_.empty())
+        {
+            ok = SpillRun(&run_dir, &run_paths);
+        }
+        LOG(INFO) << "Index Build External, doc_cnt=" << doc_cnt << " run_cnt=" << run_paths.size();
+
+        //4. 多路归并所有的 run，写到索引文件的倒排部分
+        ok = ok && MergeRuns(run_paths, &writer) && writer.Finish();
+    }
+    index_file.close();
+    file.close();
+    if(!ok)
+    {
+        LOG(ERROR) << "Index Build External failed! output_path:" << output_path;
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    CHECK(std::rename(tmp_path.c_str(), output_path.c_str()) == 0) << "output_path:" << output_path;
+    LOG(INFO) << "Index Build External Done!!!";
+    return true;
+}
+
+//粗略估算内存中的倒排占用的内存大小
+//词典的大小，加上每个拉链的 vector 的开销和拉链中的元素
+size_t Index::EstimateInvertedSize() const
+{
+    size_t size = inverted_index_.dict.MemoryUsage();
+    for(const auto& inverted_list : inverted_index_.lists)
+    {
+        size += sizeof(InvertedList) + inverted_list.doc_ids.capacity() * sizeof(Posting)
+                + (inverted_list.positions.capacity() + inverted_list.position_ends.capacity()) * sizeof(uint32_t);
+    }
+    return size;
+}
+
+//把内存中的倒排按照关键词排序后写到 run_dir 中的一个临时文件中，然后清空内存中的倒排
+bool Index::SpillRun(common::TmpDir* run_dir, std::vector<std::string>* run_paths)
+{
+    std::string run_path = run_dir->NewFile("index_run_" + std::to_string(run_paths->size()));
+    std::ofstream file(run_path.c_str(), std::ios::binary);
+    if(!file.is_open())
+    {
+        PLOG(ERROR) << "SpillRun open failed! run_path:" << run_path;
+        return false;
+    }
+    std::vector<uint32_t> term_ids;
+    inverted_index_.dict.SortedIds(&term_ids);
+    doc_index_proto::KwdInfo kwd_info;
+    for(uint32_t term_id : term_ids)
+    {
+        ConvertKwdInfo(inverted_index_.dict.term(term_id), inverted_index_.lists[term_id], &kwd_info);
+        if(!google::protobuf::util::SerializeDelimitedToOstream(kwd_info, &file))
+        {
+            LOG(ERROR) << "SpillRun write failed! run_path:" << run_path;
+            return false;
+        }
+    }
+    file.close();
+    if(!file)
+    {
+        LOG(ERROR) << "SpillRun write failed! run_path:" << run_path;
+        return false;
+    }
+    InvertedIndex().swap(inverted_index_);
+    run_paths->push_back(run_path);
+    LOG(INFO) << "SpillRun " << run_path;
+    return true;
+}
+
+//多路归并，每次从所有 run 中取出关键词最小的拉链，关键词相同的按照 run 的顺序拼接
+bool Index::MergeRuns(const std::vector<std::string>& run_paths, IndexWriter* writer)
+{
+    std::vector<std::unique_ptr<InvertedRun>> runs;
+    for(const auto& run_path : run_paths)
+    {
+        runs.push_back(std::unique_ptr<InvertedRun>(new InvertedRun()));
+        if(!runs.back()->Open(run_path))
+        {
+            LOG(ERROR) << "MergeRuns open failed! run_path:" << run_path;
+            return false;
+        }
+    }
+
+    //堆里面存的是 run 的下标，堆顶是当前关键词最小的 run，关键词相同时下标小的在前
+    auto cmp = [&runs](size_t r1, size_t r2)
+    {
+        int ret = runs[r1]->kwd_info.key().compare(runs[r2]->kwd_info.key());
+        return ret > 0 || (ret == 0 && r1 > r2);
+    };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(cmp)> heap(cmp);
+    for(size_t i = 0; i < runs.size(); ++i)
+    {
+        if(runs[i]->Next())
+        {
+            heap.push(i);
+        }
+    }
+
+    std::string key;
+    InvertedList inverted_list;
+    while(!heap.empty())
+    {
+        key = runs[heap.top()]->kwd_info.key();
+        inverted_list.clear();
+        while(!heap.empty() && runs[heap.top()]->kwd_info.key() == key)
+        {
+            size_t i = heap.top();
+            heap.pop();
+            const auto& doc_list = runs[i]->kwd_info.doc_list();
+            for(const auto& weight : doc_list)
+            {
+                Posting posting = {(uint32_t)weight.doc_id(), (uint16_t)weight.title_tf(),
+                                   (uint16_t)weight.content_tf(), weight.first_pos()};
+                if(weight.positions_size() == 0)
+                {
+                    inverted_list.push_back(posting);
+                    continue;
+                }
+                inverted_list.push_back(posting, weight.positions().data(), weight.positions_size());
+            }
+            if(runs[i]->Next())
+            {
+                heap.push(i);
+            }
+        }
+        writer->AddTerm(key, inverted_list);
+    }
+    return true;
+}
+
+bool Index::BuildForward(const std::string& line, uint64_t doc_id, cppjieba::Jieba* jieba, DocInfo* doc_info)
 {
     std::vector<std::string> tokens;
     //当前Split 不会破坏原字符串
@@ -60,45 +445,45 @@ const DocInfo* Index::BuildForward(const std::string& line)
     if(tokens.size() != 3)
     {
         LOG(FATAL) << "line split not 3 tokens! tokens.size() = " << tokens.size();
-        return NULL;
+        return false;
     }
-    //切分成功后的tokens，保存了id,title,content等信息(每个元素为一个信息)，id为正排数组的size
-    //2. 构造一个DocInfo结构，把切分的结果赋值到DocInfo
+    //切分成功后的tokens，保存了url,title,content等信息(每个元素为一个信息)，id为正排数组的下标
+    return BuildDocInfo(doc_id, tokens[0], tokens[1], tokens[2], jieba, doc_info);
+}
+
+//根据文档的 url，标题，正文构造出一个 DocInfo
+bool Index::BuildDocInfo(uint64_t doc_id, const std::string& jump_url, const std::string& title,
+                         const std::string& content, cppjieba::Jieba* jieba, DocInfo* doc_info)
+{
+    //1. 构造一个DocInfo结构，把切分的结果赋值到DocInfo
     //   除了分词结果之外都能直接进行赋值
-    DocInfo doc_info;
-    doc_info.set_id(forward_index_.size());
-    doc_info.set_title(tokens[1]);
-    doc_info.set_content(tokens[2]);
-    doc_info.set_jump_url(tokens[0]);
+    doc_info->set_id(doc_id);
+    doc_info->set_title(title);
+    doc_info->set_content(content);
+    doc_info->set_jump_url(jump_url);
     //这里为了方便，将show_url与jump_url设置为一样
     //实际上show_url只包含jump_url的域名
-    doc_info.set_show_url(doc_info.jump_url());
+    doc_info->set_show_url(doc_info->jump_url());
     
-    //3. 这里为了方便倒排，将标题和正文的分词结果保存在doc_info中的
+    //2. 这里为了方便倒排，将标题和正文的分词结果保存在doc_info中的
     //   title_token与content_token中(为左闭右开的区间)
     //   doc_info是输出型参数，用指针的方式传入
-    SplitTitle(tokens[1], &doc_info);
-    SplitContent(tokens[2], &doc_info);
-
-    //4. 将这个DocInfo 插入到正排索引中
-    forward_index_.push_back(doc_info);
-    return &forward_index_.back();
-
+    return SplitTitle(title, jieba, doc_info) && SplitContent(content, jieba, doc_info);
 }
 
-void Index::SplitTitle(const std::string& title, DocInfo* doc_info)
+bool Index::SplitTitle(const std::string& title, cppjieba::Jieba* jieba, DocInfo* doc_info)
 {
     std::vector<cppjieba::Word> words;
     //要调用 cppjieba 进行分词，需要先创建一个jieba对象
-    jieba_.CutForSearch(title, words);
+    jieba->CutForSearch(title, words);
     //words里面包含的分词结果，每一个结果包含一个offset。
     //offset表示的是当前词在文档中的其实位置的下标，但是这里
     //我们需要的是前闭后开区间
     if(words.size() < 1)
     {
-        //错误处理
-        LOG(FATAL) << "SplitTitle failed! title = " << title;
-        return;
+        //错误处理，由调用者决定是否终止进程
+        LOG(ERROR) << "SplitTitle failed! title = " << title;
+        return false;
     }
 
     for(size_t i = 0; i < words.size(); ++i)
@@ -118,22 +503,22 @@ void Index::SplitTitle(const std::string& title, DocInfo* doc_info)
         }
     }
 
-    return;
+    return true;
 }
 
-void Index::SplitContent(const std::string& content, DocInfo* doc_info)
+bool Index::SplitContent(const std::string& content, cppjieba::Jieba* jieba, DocInfo* doc_info)
 {
     std::vector<cppjieba::Word> words;
     //要调用cppjieba进行分词，需要创建一个jieba对象
-    jieba_.CutForSearch(content, words);
+    jieba->CutForSearch(content, words);
     //words里面包含包含的分词结果，每个结果包含一个 offset
     //offset表示的是当前词在文档中的起始位置的下标
     //而世界上这里我们需要的是前闭后开区间
     if(words.size() <= 1)
     {
-        //错误处理
-        LOG(FATAL) << "SplitContent failed!";
-        return;
+        //错误处理，由调用者决定是否终止进程
+        LOG(ERROR) << "SplitContent failed!";
+        return false;
     }
 
     for(size_t i = 0; i < words.size(); ++i)
@@ -153,22 +538,30 @@ void Index::SplitContent(const std::string& content, DocInfo* doc_info)
         }
     }
 
-    return;
+    return true;
 }
 
 
-void Index::BuildInverted(const DocInfo& doc_info)
+void Index::BuildInverted(const DocInfo& doc_info, InvertedIndex* inverted_index)
 {
+    //倒排拉链中的文档id只有32位
+    CHECK_LE(doc_info.id(), std::numeric_limits<uint32_t>::max());
+    //HELLO hello在这里算一个词，大小写不敏感
+    //标题和正文整体各转一次小写，每个词直接用 StringPiece 指向转换之后的内容，
+    //不需要为每个词构造一个 std::string
+    std::string title = doc_info.title();
+    boost::to_lower(title);
+    std::string content = doc_info.content();
+    boost::to_lower(content);
+
     WordCntMap word_cnt_map; //key为关键词，value为结构体，结构体的内容为，词在正文，标题的出现次数
+    word_cnt_map.reserve(doc_info.title_token_size() + doc_info.content_token_size());
     //1. 统计 title 中每个词出现的次数
     for(int i = 0; i < doc_info.title_token_size(); ++i)
     {
         const auto& token = doc_info.title_token(i);
         //因为这里的token数组里面存的区间，真正的内容在title中
-        std::string word = doc_info.title().substr(token.beg(), token.end() - token.beg());
-
-        //HELLO hello在这里算一个词，大小写不敏感
-        boost::to_lower(word);
+        common::StringPiece word = common::StringPiece(title).substr(token.beg(), token.end() - token.beg());
 
         //去掉暂停词
         if(stop_word_dict_.Find(word))
@@ -177,8 +570,13 @@ void Index::BuildInverted(const DocInfo& doc_info)
         }
 
         //存在，值就++；否则，插入
-        ++word_cnt_map[word].title_cnt;
-        
+        WordCnt& word_cnt = word_cnt_map[word];
+        ++word_cnt.title_cnt;
+        if(fLB::FLAGS_index_positions)
+        {
+            word_cnt.positions.push_back(i);
+        }
+
     }
 
     //2. 统计content中每个词出现的个数
@@ -188,169 +586,314 @@ void Index::BuildInverted(const DocInfo& doc_info)
     for(int i = 0; i < doc_info.content_token_size(); ++i)
     {
         const auto& token = doc_info.content_token(i);
-        std::string word = doc_info.content().substr(token.beg(), token.end() - token.end());
-        boost::to_lower(word);
+        common::StringPiece word = common::StringPiece(content).substr(token.beg(), token.end() - token.beg());
         if(stop_word_dict_.Find(word))
         {
             continue;
         }
-        ++word_cnt_map[word].content_cnt;
+        WordCnt& word_cnt = word_cnt_map[word];
         //记录词在正文中第一次出现的位置--方便以后返回响应的时候构建描述信息
-        if(word_cnt_map[word].content_cnt == 1)
+        if(++word_cnt.content_cnt == 1)
         {
-            word_cnt_map[word].first_pos = token.beg();
+            word_cnt.first_pos = token.beg();
+        }
+        //正文的位置接在标题后面，中间空出 kFieldGap，短语不会跨越标题和正文
+        if(fLB::FLAGS_index_positions)
+        {
+            word_cnt.positions.push_back(doc_info.title_token_size() + kFieldGap + i);
         }
     }
     //3. 根据统计结果，更新到倒排索引InvertedIndex中
-    //   遍历刚才的hash表，拿着key去倒排索引中查找
-    //   如果倒排索引中不存在这个词，就新增一项
-    //   否则，就构造一个Weight结构，将其添加到
-    //   对应的倒排拉链InvertedList当中
+    //   遍历刚才的hash表，拿着key去词典中查到关键词的id
+    //   (不存在就分配一个新的id)，再构造一个Posting结构，
+    //   添加到这个id对应的倒排拉链InvertedList当中
     for(const auto& word_pair : word_cnt_map)
     {
-        Weight weight;
-        weight.set_doc_id(doc_info.id());
-        //这里构造Weight结构，得先计算权重，second为value，first为key
-        weight.set_weight(CalcWeight(word_pair.second.title_cnt, word_pair.second.content_cnt));
-        weight.set_first_pos(word_pair.second.first_pos);
+        Posting posting;
+        posting.doc_id = doc_info.id();
+        //拉链中只保存词频，second为value，first为key
+        //得分和文档长度、包含这个词的文档数都有关系，在查询的时候计算(见 bm25.h)
+        posting.title_tf = std::min<uint32_t>(word_pair.second.title_cnt, kMaxTf);
+        posting.content_tf = std::min<uint32_t>(word_pair.second.content_cnt, kMaxTf);
+        posting.first_pos = word_pair.second.first_pos;
 
         //先获取到当前词对应的倒排拉链
-        InvertedList& inverted_list = inverted_index_[word_pair.first];
-        inverted_list.push_back(weight);
+        InvertedList& inverted_list = (*inverted_index)[word_pair.first];
+        const std::vector<uint32_t>& positions = word_pair.second.positions;
+        if(positions.empty())
+        {
+            inverted_list.push_back(posting);
+            continue;
+        }
+        inverted_list.push_back(posting, positions.data(), positions.size());
     }
 
     return;
 }
 
-int Index::CalcWeight(int title_cnt, int content_cnt)
-{
-    //这里权重直接简单的进行计算
-    return 10 * title_cnt + content_cnt;
-}
-
-void Index::SortInverted()
+//把内存中的索引数据保存到磁盘中，文件格式见 index_file.h
+//已经加载的索引(增量构建时)和新构建的部分合并在一起写出：
+//正排先写加载进来的文档，再写新构建的文档；
+//倒排按照关键词的顺序把两边归并，只在一边出现的关键词直接写入(加载进来的拉链不需要解压)，
+//两边都有的关键词，新文档的id都比已有的文档大，把已有的拉链解压出来接上新文档的拉链再重新压缩
+bool Index::Save(const std::string& ouput_path)
 {
-    //把所有的倒排拉链都按照weight降序排序
-    for(auto& inverted_pair : inverted_index_)
+    LOG(INFO) << "Index Save";
+    //先写到临时文件，写完之后再 rename，服务器监视索引文件时不会加载到写了一半的文件，
+    //已经 mmap 了旧文件的进程也不受影响
+    std::string tmp_path = ouput_path + ".tmp";
+    std::ofstream file(tmp_path.c_str(), std::ios::binary);
+    if(!file.is_open())
     {
-        //每个inverted_pair时一个键值对
-        //key为关键词，value为weight的数组
-        //每个weight里面为文档id和权重
-        InvertedList& inverted_list = inverted_pair.second;
-        std::sort(inverted_list.begin(), inverted_list.end(), CmpWeight);
+        LOG(ERROR) << "Index Save open failed, ouput_path:" << tmp_path;
+        return false;
+    }
+    IndexWriter writer(&file);
+    SnapshotRef snapshot(this);
+    const IndexReader& reader = snapshot->reader;
+    //1. 写正排
+    DocView doc;
+    for(uint64_t doc_id = 0; doc_id < reader.doc_cnt(); ++doc_id)
+    {
+        reader.GetDoc(doc_id, &doc);
+        writer.AddDoc(doc);
+    }
+    for(const auto& doc_info : forward_index_)
+    {
+        ToDocView(doc_info, &doc);
+        writer.AddDoc(doc);
     }
-    return;
-}
 
-bool Index::CmpWeight(const Weight& w1, const Weight& w2)
-{
-    return w1.weight() > w2.weight();
-}
+    //2. 按照关键词的顺序写倒排
+    //  构建中的倒排按照关键词id存放，先按照关键词排好序，
+    //  保证相同的数据(不管是怎样构建的)得到的索引文件完全一样
+    std::vector<uint32_t> term_ids;
+    inverted_index_.dict.SortedIds(&term_ids);
+    InvertedList inverted_list;
+    size_t i = 0;
+    TermIterator base_it(reader);
+    while(i < term_ids.size() || base_it.Valid())
+    {
+        int ret = 0;
+        if(i == term_ids.size())
+        {
+            ret = 1;
+        }
+        else if(!base_it.Valid())
+        {
+            ret = -1;
+        }
+        else
+        {
+            ret = inverted_index_.dict.term(term_ids[i]).compare(base_it.term());
+        }
 
-//把内存中的索引数据保存到磁盘中
-bool Index::Save(const std::string& ouput_path)
-{
-    LOG(INFO) << "Index Save";
-    //1. 把内存中的索引结构序列化成字符串
-    std::string proto_data;
-    CHECK(ConvertToProto(&proto_data));
-    //2. 把序列化得到的字符串写到文件中
-    CHECK(common::FileUtil::Write(ouput_path, proto_data));
+        if(ret > 0)
+        {
+            PostingList posting_list = base_it.posting_list();
+            PositionList position_list = base_it.position_list();
+            writer.AddTerm(base_it.term(), common::StringPiece(posting_list.data(), posting_list.len()),
+                           common::StringPiece(position_list.data(), position_list.len()));
+            base_it.Next();
+            continue;
+        }
+        const InvertedList& new_list = inverted_index_.lists[term_ids[i]];
+        if(ret < 0)
+        {
+            writer.AddTerm(inverted_index_.dict.term(term_ids[i]), new_list);
+        }
+        else
+        {
+            //已有的拉链没有位置索引时(从 protobuf 格式的索引文件转换来的)，合并之后也没有
+            base_it.posting_list().Decode(&inverted_list);
+            base_it.position_list().Decode(&inverted_list);
+            inverted_list.append(new_list);
+            writer.AddTerm(inverted_index_.dict.term(term_ids[i]), inverted_list);
+            base_it.Next();
+        }
+        ++i;
+    }
+    CHECK(writer.Finish()) << "ouput_path:" << tmp_path;
+    file.close();
+    CHECK(std::rename(tmp_path.c_str(), ouput_path.c_str()) == 0) << "ouput_path:" << ouput_path;
     LOG(INFO) << "Index Save Done";
 
     return true;
 }
 
-bool Index::ConvertToProto(std::string* proto_data)
+//把一个关键词和它的倒排拉链转换成 KwdInfo，拉链不压缩，外部归并的临时文件使用
+void Index::ConvertKwdInfo(const std::string& key, const InvertedList& inverted_list,
+                           doc_index_proto::KwdInfo* kwd_info)
 {
-    //index.proto中的命名空间
-    doc_index_proto::Index index; //index中包含正排索引和倒排索引(倒排索引也是数组，由于protobuf中没有hash的类型)
-    //需要把内存中的数据设置到 index 中
-    //1. 设置正排
-    for(const auto& doc_info : forward_index_)
+    kwd_info->Clear();
+    kwd_info->set_key(key);
+    //value为Weight结构的数组，里面包含文档id和词频
+    for(size_t i = 0; i < inverted_list.size(); ++i)
     {
-        //创建一个空间
-        auto* proto_doc_info = index.add_forward_index();
-        //给空间赋值
-        *proto_doc_info = doc_info;
-    }
-
-    //2. 设置倒排
-    for(const auto& inverted_pair : inverted_index_)
-    {
-        //创建空间，每一个空间为键值对结构
-        auto* kwd_info = index.add_inverted_index();
-        kwd_info->set_key(inverted_pair.first);
-        //value为Weight结构的数组，里面包含文档id和权重
-        for(const auto& weight : inverted_pair.second)
+        auto* weight = kwd_info->add_doc_list();
+        weight->set_doc_id(inverted_list.doc_ids[i]);
+        weight->set_first_pos(inverted_list.first_pos[i]);
+        weight->set_title_tf(inverted_list.title_tf[i]);
+        weight->set_content_tf(inverted_list.content_tf[i]);
+        if(inverted_list.has_positions())
         {
-            //创建倒排拉链的空间
-            auto* proto_weight = kwd_info->add_doc_list();
-            *proto_weight = weight;
+            for(uint32_t j = inverted_list.position_beg(i); j < inverted_list.position_ends[i]; ++j)
+            {
+                weight->add_positions(inverted_list.positions[j]);
+            }
         }
     }
+}
 
-    //序列化，将序列化好的字符串保存在proto_data中
-    index.SerializeToString(proto_data);
-    return true;
+void Index::ToDocView(const DocInfo& doc_info, DocView* doc)
+{
+    doc->id = doc_info.id();
+    doc->title = doc_info.title();
+    doc->content = doc_info.content();
+    doc->show_url = doc_info.show_url();
+    doc->jump_url = doc_info.jump_url();
+    //文档长度就是分词之后的词数
+    doc->length.title_len = doc_info.title_token_size();
+    doc->length.content_len = doc_info.content_token_size();
+    //实时段中的文档没有句子起始位置表，生成描述时往前扫描
+    doc->sentence_starts = common::StringPiece();
+    //分词结果编码之后由 block 持有
+    std::shared_ptr<std::string> tokens(new std::string());
+    int32_t last_beg = 0;
+    for(int i = 0; i < doc_info.content_token_size(); ++i)
+    {
+        ContentTokenIterator::Append(doc_info.content_token(i).beg(), &last_beg, tokens.get());
+    }
+    doc->content_tokens = *tokens;
+    doc->block = tokens;
 }
 
-//把磁盘上的文件加载到内存的索引结构中
+//加载磁盘上的索引文件
+//新的快照完全加载好之后才替换当前的快照，加载过程中的查询仍然使用当前的索引，不会等待
 bool Index::Load(const std::string& index_path)
 {
     LOG(INFO) << "Index Load";
-    std::cout << "Into Load\n";
-    //1. 从磁盘上把索引文件读到内存中
-    std::string proto_data;
-    CHECK(common::FileUtil::Read(index_path, &proto_data));
-    std::cout << "read over\n";
-    //2. 进行反序列化，转成内存中的索引结构
-    CHECK(ConvertFromProto(proto_data));
-    LOG(INFO) << "Index Load Done";
+    std::lock_guard<std::mutex> load_lock(load_mutex_);
+    std::shared_ptr<IndexSnapshot> snapshot(new IndexSnapshot());
+    IndexReader& reader = snapshot->reader;
+    //1. 索引文件直接 mmap 进来
+    if(!reader.Open(index_path))
+    {
+        //2. 旧版本的索引文件是 protobuf 格式的，反序列化之后在内存中转换成新的格式
+        LOG(INFO) << "Index Load legacy format, index_path:" << index_path;
+        std::string proto_data;
+        if(!common::FileUtil::Read(index_path, &proto_data))
+        {
+            LOG(ERROR) << "Index Load read failed, index_path:" << index_path;
+            return false;
+        }
+        //能识别的版本打开失败说明文件损坏了(Init 中检查不通过)
+        if(IndexReader::IsIndexFile(proto_data))
+        {
+            LOG(ERROR) << "index file corrupted, index_path:" << index_path;
+            return false;
+        }
+        //其他版本的 mmap 格式的索引文件只能重新构建
+        if(proto_data.compare(0, 6, "DOCIDX") == 0)
+        {
+            LOG(ERROR) << "index file version not supported, please rebuild it, index_path:" << index_path;
+            return false;
+        }
+        std::string index_data;
+        if(!ConvertFromProto(proto_data, &index_data) || !reader.OpenBuffer(&index_data))
+        {
+            LOG(ERROR) << "Index Load convert failed, index_path:" << index_path;
+            return false;
+        }
+    }
+    reader.set_doc_cache_capacity(fLI::FLAGS_doc_cache_block_cnt);
+    //3. 分配删除位图和实时段的正排、文档长度表，实时段中的文档也要用到删除位图
+    snapshot->deleted_size = reader.doc_cnt() + fLI::FLAGS_realtime_max_doc_cnt;
+    snapshot->realtime_docs.reset(new std::unique_ptr<DocInfo>[fLI::FLAGS_realtime_max_doc_cnt]);
+    snapshot->realtime_lengths.reset(new DocLength[fLI::FLAGS_realtime_max_doc_cnt]);
+    snapshot->deleted.reset(new std::atomic<uint64_t>[(snapshot->deleted_size + 63) / 64]);
+    for(uint64_t i = 0; i < (snapshot->deleted_size + 63) / 64; ++i)
+    {
+        snapshot->deleted[i].store(0, std::memory_order_relaxed);
+    }
+    snapshot->generation = ++load_cnt_;
+    //4. 把当前快照上在线新增和删除的文档重放到新的快照上，然后替换当前的快照
+    //   重放到替换的整个过程持有旧快照的 write_mutex，等在锁上的写操作拿到锁之后发现旧快照已经
+    //   retired，会重新到新的快照上写，不会有写操作落在被替换掉的快照上
+    //   旧的快照在正在使用它的请求都结束之后释放，先替换再增加版本，读到新版本的请求一定使用新的快照
+    std::shared_ptr<IndexSnapshot> old_snapshot = this->snapshot();
+    {
+        std::lock_guard<std::mutex> old_lock(old_snapshot->write_mutex);
+        std::lock_guard<std::mutex> lock(snapshot->write_mutex);
+        ReplayRealtime(*old_snapshot, snapshot.get());
+        old_snapshot->retired = true;
+        std::atomic_store(&snapshot_, snapshot);
+    }
+    version_.fetch_add(1, std::memory_order_release);
+    LOG(INFO) << "Index Load Done, doc_cnt=" << reader.doc_cnt() << " term_cnt=" << reader.term_cnt();
     return true;
 }
 
-bool Index::ConvertFromProto(const std::string& proto_data)
+//旧版本的索引文件的内容是一个序列化之后的 doc_index_proto::Index，
+//转换成新格式的索引文件数据，放到 index_data 中
+bool Index::ConvertFromProto(const std::string& proto_data, std::string* index_data)
 {
     //1. 对索引文件内容进行反序列化
     doc_index_proto::Index index;
-    index.ParseFromString(proto_data);
-    //2. 已经反序列化好的数据在index中，
-    //   将index中的内容构建成内存中的索引结构
-    //   构建正排索引forward_index_
+    if(!index.ParseFromString(proto_data))
+    {
+        LOG(ERROR) << "ConvertFromProto ParseFromString failed!";
+        return false;
+    }
+    std::ostringstream output;
+    IndexWriter writer(&output);
+    //2. 写正排，同时根据正排中保存的分词结果重新构建倒排
+    //   旧版本的拉链中只有权重，没有打分需要的词频，不能直接转换
+    DocView doc;
+    InvertedIndex inverted_index;
     for(int i = 0; i < index.forward_index_size(); ++i)
     {
-        const auto& doc_info = index.forward_index(i);
-        forward_index_.push_back(doc_info);
+        ToDocView(index.forward_index(i), &doc);
+        writer.AddDoc(doc);
+        BuildInverted(index.forward_index(i), &inverted_index);
     }
 
-    //3. 构建倒排索引inverted_index_
-    for(int i = 0; i < index.inverted_index_size(); ++i)
+    //3. 按照关键词的顺序写倒排
+    std::vector<uint32_t> term_ids;
+    inverted_index.dict.SortedIds(&term_ids);
+    for(uint32_t term_id : term_ids)
     {
-        //kwd_info为结构体，包含关键词key和weight数组(倒排拉链)
-        const auto& kwd_info = index.inverted_index(i);
-        //找到key在inverted_index_(内存中的倒排索引)
-        //对应的倒排拉链,然后再把对应的weight插入进去
-        InvertedList& inverted_list = inverted_index_[kwd_info.key()];
-        for(int j = 0; j < kwd_info.doc_list_size(); ++j)
-        {
-            const auto& weight = kwd_info.doc_list(j);
-            inverted_list.push_back(weight);
-        }
+        writer.AddTerm(inverted_index.dict.term(term_id), inverted_index.lists[term_id]);
+    }
+    if(!writer.Finish())
+    {
+        return false;
     }
+    *index_data = output.str();
     return true;
 }
 
-//调试用的接口，把内存中的索引结构按照一定的格式打印到文件中
+//调试用的接口，把索引的内容按照一定的格式打印到文件中
 bool Index::Dump(const std::string& forward_dump_path, const std::string& inverted_dump_path)
 {
     LOG(INFO) << "Index dump";
     //1. 处理正排
     std::ofstream forward_dump_file(forward_dump_path.c_str());
     CHECK(forward_dump_file.is_open());
-    for(size_t i = 0; i < forward_index_.size(); ++i)
+    SnapshotRef snapshot(this);
+    const IndexReader& reader = snapshot->reader;
+    DocView doc;
+    DocInfo doc_info;
+    for(uint64_t doc_id = 0; doc_id < reader.doc_cnt(); ++doc_id)
     {
-        const DocInfo& doc_info = forward_index_[i];
+        //转成 DocInfo 再打印，格式和以前保持一样
+        reader.GetDoc(doc_id, &doc);
+        doc_info.Clear();
+        doc_info.set_id(doc.id);
+        doc_info.set_title(doc.title.data(), doc.title.size());
+        doc_info.set_content(doc.content.data(), doc.content.size());
+        doc_info.set_show_url(doc.show_url.data(), doc.show_url.size());
+        doc_info.set_jump_url(doc.jump_url.data(), doc.jump_url.size());
         forward_dump_file << doc_info.Utf8DebugString() << "====================";
     }
 
@@ -359,12 +902,27 @@ bool Index::Dump(const std::string& forward_dump_path, const std::string& invert
     //2. 处理倒排
     std::ofstream inverted_dump_file(inverted_dump_path.c_str());
     CHECK(inverted_dump_file.is_open());
-    for(const auto& inverted_pair : inverted_index_)
+    InvertedList inverted_list;
+    for(TermIterator it(reader); it.Valid(); it.Next())
     {
-        inverted_dump_file << inverted_pair.first << "\n";
-        for(const auto& weight : inverted_pair.second)
+        inverted_dump_file << it.term() << "\n";
+        it.posting_list().Decode(&inverted_list);
+        it.position_list().Decode(&inverted_list);
+        for(size_t j = 0; j < inverted_list.size(); ++j)
         {
-            inverted_dump_file << weight.Utf8DebugString();
+            inverted_dump_file << "doc_id: " << inverted_list.doc_ids[j] << "\n"
+                               << "title_tf: " << inverted_list.title_tf[j] << "\n"
+                               << "content_tf: " << inverted_list.content_tf[j] << "\n"
+                               << "first_pos: " << inverted_list.first_pos[j] << "\n";
+            if(inverted_list.has_positions())
+            {
+                inverted_dump_file << "positions:";
+                for(uint32_t k = inverted_list.position_beg(j); k < inverted_list.position_ends[j]; ++k)
+                {
+                    inverted_dump_file << " " << inverted_list.positions[k];
+                }
+                inverted_dump_file << "\n";
+            }
         }
         inverted_dump_file << "===================";
     }
@@ -374,43 +932,114 @@ bool Index::Dump(const std::string& forward_dump_path, const std::string& invert
 }
 
 //根据 doc_id 获取到文档详细信息
-const DocInfo* Index::GetDocInfo(uint64_t doc_id) const
+bool Index::GetDocInfo(uint64_t doc_id, DocView* doc) const
 {
-    if(doc_id >= forward_index_.size())
+    SnapshotRef snapshot(this);
+    if(doc_id >= snapshot->reader.doc_cnt())
     {
-        return NULL;
+        //可能是实时段中的文档，已经加入的文档不会再改变，doc 可以直接指向它
+        uint64_t realtime_id = doc_id - snapshot->reader.doc_cnt();
+        if(realtime_id >= snapshot->realtime_doc_cnt.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        ToDocView(*snapshot->realtime_docs[realtime_id], doc);
+        return true;
     }
 
-    return &forward_index_[doc_id];
+    return snapshot->reader.GetDoc(doc_id, doc);
+}
+
+uint64_t Index::DocCnt() const
+{
+    return SnapshotRef(this)->DocCnt();
+}
+
+//打分需要的文档总数包含实时段中的文档，平均长度和最短长度只统计已加载的索引文件，
+//实时段中的文档相对很少，对平均长度的影响可以忽略
+void Index::GetScorer(uint64_t df, Bm25Scorer* scorer) const
+{
+    SnapshotRef snapshot(this);
+    Bm25Stats stats;
+    stats.doc_cnt = snapshot->DocCnt();
+    stats.avg_title_len = snapshot->reader.avg_title_len();
+    stats.avg_content_len = snapshot->reader.avg_content_len();
+    stats.min_length = snapshot->reader.min_length();
+    *scorer = Bm25Scorer(stats, df);
+}
+
+bool Index::GetInvertedList(const std::string& key, PostingList* posting_list,
+                            PositionList* positions) const
+{
+    //在有序的词典中二分查找，拉链直接指向索引文件中的数据
+    return SnapshotRef(this)->reader.FindTerm(key, posting_list, positions);
 }
 
-const InvertedList* Index::GetInvertedList(const std::string& key) const
+//按照字典序列出 [beg, end) 范围内的关键词，end 为空表示不限制，最多 max_cnt 个
+void Index::GetTermsInRange(const std::string& beg, const std::string& end, size_t max_cnt,
+                            std::vector<std::string>* terms) const
 {
-    //这里的find找到后会返回对应的迭代器
-    //但是[]返回的是valuei,并且find找不到
-    //的话会返回end可以用来判断是否存在
-    //但是[]不存在的话就直接插入了
-    auto it = inverted_index_.find(key);
-    if(it == inverted_index_.end())
+    terms->clear();
+    SnapshotRef snapshot(this);
+    TermIterator it(snapshot->reader);
+    it.Seek(beg);
+    for(; it.Valid() && terms->size() < max_cnt; it.Next())
     {
-        return NULL;
+        if(!end.empty() && it.term() >= end)
+        {
+            break;
+        }
+        terms->push_back(it.term());
     }
+}
 
-    return &(it->second);
+//按照字典序列出以 prefix 开头的关键词，最多 max_cnt 个
+void Index::GetTermsWithPrefix(const std::string& prefix, size_t max_cnt,
+                               std::vector<std::string>* terms) const
+{
+    terms->clear();
+    SnapshotRef snapshot(this);
+    TermIterator it(snapshot->reader);
+    it.Seek(prefix);
+    for(; it.Valid() && terms->size() < max_cnt; it.Next())
+    {
+        if(it.term().compare(0, prefix.size(), prefix) != 0)
+        {
+            break;
+        }
+        terms->push_back(it.term());
+    }
 }
 
 //此处为了方便服务器进行分词，再提供一个函数
 //需要把所有的暂停词从分词结果中过滤掉
 void Index::CutWordWithoutStopWord(const std::string& query, std::vector<std::string>* words)
 {
+    std::vector<uint32_t> offsets;
+    CutWordWithoutStopWord(query, words, &offsets);
+}
+
+//和构建位置索引时一样，暂停词虽然去掉了，但是也占一个位置
+void Index::CutWordWithoutStopWord(const std::string& query, std::vector<std::string>* words,
+                                   std::vector<uint32_t>* offsets)
+{
+    std::shared_ptr<const CutResult> cached;
+    if(cut_cache_.Get(query, &cached))
+    {
+        *words = cached->words;
+        *offsets = cached->offsets;
+        return;
+    }
     //将最后的分词结果保存再word中
     words->clear();
+    offsets->clear();
     std::vector<std::string> tmp;
     //由于分完词之后，暂停词还在
     //这里我们需要将暂停词去掉放到word中
     jieba_.CutForSearch(query, tmp);
-    for(std::string& token : tmp)
+    for(size_t i = 0; i < tmp.size(); ++i)
     {
+        std::string& token = tmp[i];
         //判定是否为暂停词对大小写不敏感
         boost::to_lower(token);
         if(stop_word_dict_.Find(token))
@@ -418,11 +1047,230 @@ void Index::CutWordWithoutStopWord(const std::string& query, std::vector<std::st
             continue;
         }
         words->push_back(token);
+        offsets->push_back(i);
     }
+    std::shared_ptr<CutResult> result(new CutResult());
+    result->words = *words;
+    result->offsets = *offsets;
+    cut_cache_.Put(query, result);
 }
 
 
-} //end doc_index
+//新增文档，放到实时段中
+bool Index::AddDocument(const std::string& jump_url, const std::string& title,
+                        const std::string& content, uint64_t* doc_id)
+{
+    //1. 分词比较耗时，在锁外面完成，文档id等加锁之后再分配
+    std::unique_ptr<DocInfo> doc_info(new DocInfo());
+    if(!BuildDocInfo(0, jump_url, title, content, &jieba_, doc_info.get()))
+    {
+        LOG(ERROR) << "AddDocument BuildDocInfo failed! jump_url=" << jump_url;
+        return false;
+    }
 
+    //写操作总是在最新的快照上进行，不使用本线程固定的快照
+    //拿到锁时快照已经被重新加载替换掉的话，到新的快照上重试
+    while(true)
+    {
+        std::shared_ptr<IndexSnapshot> snapshot = this->snapshot();
+        std::lock_guard<std::mutex> lock(snapshot->write_mutex);
+        if(snapshot->retired)
+        {
+            continue;
+        }
+        if(!AddToSnapshot(snapshot.get(), std::move(doc_info), doc_id))
+        {
+            return false;
+        }
+        version_.fetch_add(1, std::memory_order_release);
+        LOG(INFO) << "AddDocument doc_id=" << *doc_id << " jump_url=" << jump_url;
+        return true;
+    }
+}
 
+bool Index::DeleteDocument(const std::string& jump_url)
+{
+    while(true)
+    {
+        std::shared_ptr<IndexSnapshot> snapshot = this->snapshot();
+        std::lock_guard<std::mutex> lock(snapshot->write_mutex);
+        if(snapshot->retired)
+        {
+            continue;
+        }
+        if(!DeleteFromSnapshot(snapshot.get(), jump_url))
+        {
+            return false;
+        }
+        version_.fetch_add(1, std::memory_order_release);
+        LOG(INFO) << "DeleteDocument jump_url=" << jump_url;
+        return true;
+    }
+}
+
+bool Index::AddToSnapshot(IndexSnapshot* snapshot, std::unique_ptr<DocInfo> doc_info, uint64_t* doc_id)
+{
+    uint64_t realtime_id = snapshot->realtime_doc_cnt.load(std::memory_order_relaxed);
+    *doc_id = snapshot->reader.doc_cnt() + realtime_id;
+    if(*doc_id >= snapshot->deleted_size)
+    {
+        LOG(ERROR) << "AddDocument realtime segment full! realtime_doc_cnt=" << realtime_id;
+        return false;
+    }
+    //1. 插入到实时段的正排和倒排中
+    //   正排和文档长度要在文档能被查到(倒排发布出去)之前写好
+    std::string jump_url = doc_info->jump_url();
+    doc_info->set_id(*doc_id);
+    DocView doc;
+    ToDocView(*doc_info, &doc);
+    snapshot->realtime_lengths[realtime_id] = doc.length;
+    InvertedIndex doc_inverted;
+    BuildInverted(*doc_info, &doc_inverted);
+    snapshot->realtime_docs[realtime_id] = std::move(doc_info);
+    snapshot->realtime_doc_cnt.store(realtime_id + 1, std::memory_order_release);
+    snapshot->AddRealtimePostings(doc_inverted);
 
+    //2. url 已经存在，说明是更新文档，把旧的文档标记为删除
+    uint64_t old_doc_id = 0;
+    if(snapshot->FindUrl(jump_url, &old_doc_id))
+    {
+        snapshot->MarkDeleted(old_doc_id);
+    }
+    snapshot->realtime_urls[jump_url] = *doc_id;
+    return true;
+}
+
+bool Index::DeleteFromSnapshot(IndexSnapshot* snapshot, const std::string& jump_url)
+{
+    uint64_t doc_id = 0;
+    if(!snapshot->FindUrl(jump_url, &doc_id))
+    {
+        return false;
+    }
+    snapshot->MarkDeleted(doc_id);
+    snapshot->realtime_urls[jump_url] = kDeletedDocId;
+    return true;
+}
+
+//只需要重放每个 url 最后的状态：还存在的在线新增的文档按照原来的顺序重新加入实时段，
+//在线删除的 url 在新的索引中删除
+//新的索引文件是包含了这些修改之后重新构建的时候，同样内容的文档已经在里面了，不需要重复加入
+void Index::ReplayRealtime(const IndexSnapshot& old_snapshot, IndexSnapshot* snapshot)
+{
+    uint64_t add_cnt = 0;
+    uint64_t delete_cnt = 0;
+    uint64_t realtime_cnt = old_snapshot.realtime_doc_cnt.load(std::memory_order_relaxed);
+    for(uint64_t i = 0; i < realtime_cnt; ++i)
+    {
+        const DocInfo& old_doc = *old_snapshot.realtime_docs[i];
+        if(old_snapshot.IsDeleted(old_snapshot.reader.doc_cnt() + i))
+        {
+            continue;
+        }
+        uint64_t doc_id = 0;
+        DocView doc;
+        if(snapshot->FindUrl(old_doc.jump_url(), &doc_id) && snapshot->reader.GetDoc(doc_id, &doc)
+           && doc.title == old_doc.title() && doc.content == old_doc.content())
+        {
+            continue;
+        }
+        std::unique_ptr<DocInfo> doc_info(new DocInfo(old_doc));
+        if(!AddToSnapshot(snapshot, std::move(doc_info), &doc_id))
+        {
+            LOG(ERROR) << "Index Load replay realtime doc failed! jump_url=" << old_doc.jump_url();
+            continue;
+        }
+        ++add_cnt;
+    }
+    for(const auto& url : old_snapshot.realtime_urls)
+    {
+        if(url.second == kDeletedDocId && DeleteFromSnapshot(snapshot, url.first))
+        {
+            ++delete_cnt;
+        }
+    }
+    LOG(INFO) << "Index Load replay realtime, add_cnt=" << add_cnt << " delete_cnt=" << delete_cnt;
+}
+
+bool Index::GetRealtimeInvertedList(const std::string& key, InvertedList* inverted_list) const
+{
+    SnapshotRef snapshot(this);
+    std::shared_ptr<const RealtimeChunk> last;
+    {
+        std::lock_guard<std::mutex> lock(snapshot->realtime_mutex);
+        auto it = snapshot->realtime_terms.find(key);
+        if(it == snapshot->realtime_terms.end())
+        {
+            return false;
+        }
+        last = it->second;
+    }
+    //块是从后往前串起来的，按照文档id从小到大的顺序拼接
+    std::vector<const RealtimeChunk*> chunks;
+    for(const RealtimeChunk* chunk = last.get(); chunk != NULL; chunk = chunk->prev.get())
+    {
+        chunks.push_back(chunk);
+    }
+    for(auto it = chunks.rbegin(); it != chunks.rend(); ++it)
+    {
+        inverted_list->append((*it)->list);
+    }
+    return true;
+}
+
+//在删除位图中做标记，需要在持有 write_mutex 的情况下调用
+void IndexSnapshot::MarkDeleted(uint64_t doc_id)
+{
+    if(doc_id >= deleted_size)
+    {
+        return;
+    }
+    deleted[doc_id >> 6].fetch_or(1ULL << (doc_id & 63), std::memory_order_relaxed);
+}
+
+//先看在线新增和删除过的 url，再到索引文件的 url 表中查找
+//需要在持有 write_mutex 的情况下调用
+bool IndexSnapshot::FindUrl(const std::string& jump_url, uint64_t* doc_id) const
+{
+    auto it = realtime_urls.find(jump_url);
+    if(it != realtime_urls.end())
+    {
+        *doc_id = it->second;
+        return it->second != kDeletedDocId;
+    }
+    return reader.FindUrl(jump_url, doc_id) && !IsDeleted(*doc_id);
+}
+
+//新的块在锁外面构造好，锁里面只替换各个关键词的最后一块
+//只有写操作会修改 realtime_terms，持有 write_mutex 时读它不需要 realtime_mutex
+void IndexSnapshot::AddRealtimePostings(const InvertedIndex& doc_inverted)
+{
+    std::vector<std::shared_ptr<const RealtimeChunk>> chunks;
+    chunks.reserve(doc_inverted.size());
+    for(uint32_t term_id = 0; term_id < doc_inverted.size(); ++term_id)
+    {
+        std::shared_ptr<RealtimeChunk> chunk(new RealtimeChunk());
+        auto it = realtime_terms.find(doc_inverted.dict.term(term_id));
+        if(it != realtime_terms.end())
+        {
+            if(it->second->list.size() < kRealtimeChunkSize)
+            {
+                chunk->list = it->second->list;
+                chunk->prev = it->second->prev;
+            }
+            else
+            {
+                chunk->prev = it->second;
+            }
+        }
+        chunk->list.append(doc_inverted.lists[term_id]);
+        chunks.push_back(chunk);
+    }
+    std::lock_guard<std::mutex> lock(realtime_mutex);
+    for(uint32_t term_id = 0; term_id < doc_inverted.size(); ++term_id)
+    {
+        realtime_terms[doc_inverted.dict.term(term_id)].swap(chunks[term_id]);
+    }
+}
+
+} //end doc_index
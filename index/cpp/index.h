@@ -1,12 +1,20 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
 #include <unordered_map>
 #include <cppjieba/Jieba.hpp>
 #include <glog/logging.h>
 #include <gflags/gflags.h>
 #include "index.pb.h"
+#include "posting_list.h"
+#include "index_file.h"
+#include "term_dict.h"
+#include "bm25.h"
 #include "../../common/util.hpp"
+#include "../../common/lru_cache.hpp"
 
 
 namespace doc_index
@@ -16,8 +24,7 @@ namespace doc_index
 typedef doc_index_proto::DocInfo DocInfo;
 typedef doc_index_proto::Weight Weight;
 typedef std::vector<DocInfo> ForwardIndex; //正排索引
-typedef std::vector<Weight> InvertedList; //倒排拉链，倒排索引的每一组包含一个key和一个倒排拉链
-typedef std::unordered_map<std::string, InvertedList> InvertedIndex; //倒排索引
+//构建时使用的倒排索引 InvertedIndex 见 term_dict.h
 
 
 struct WordCnt
@@ -25,6 +32,7 @@ struct WordCnt
     int title_cnt;
     int content_cnt;
     int first_pos; //记录了这个词在正文中第一次出现的位置，为了方便后面构造描述信息
+    std::vector<uint32_t> positions; //构建位置索引时，词在文档中出现的所有位置
 
     //这里八first_pos初始化为-1，为了后面判定该词在正文中是否出现过
     WordCnt()
@@ -34,18 +42,113 @@ struct WordCnt
         {}
 };
 
+//查询的分词结果(去掉暂停词之后)，offsets 为每个词在分词结果(包含暂停词)中的下标
+struct CutResult
+{
+    std::vector<std::string> words;
+    std::vector<uint32_t> offsets;
+};
+//查询 => 分词结果，分词结果只和词典有关，不会失效
+typedef common::ShardedLruCache<std::string, std::shared_ptr<const CutResult>> CutCache;
+
 //key--关键字， value-在正文，标题等出现的次数的哈希
 //为了方便建立倒排索引
 //保存的是一个文档中所有词的出现次数。
-typedef std::unordered_map<std::string, WordCnt> WordCntMap;
+//key 指向转成小写之后的标题和正文中的内容，不单独保存
+typedef std::unordered_map<common::StringPiece, WordCnt, common::StringPieceHash> WordCntMap;
+
+//实时段中一个关键词的拉链由若干个只读的块串起来，每块最多 kRealtimeChunkSize 个文档
+//新增文档时拷贝一份最后一块再追加(最后一块满了就新开一块)，已经发布出去的块不会再修改，
+//查询时只需要在锁里面取出最后一块的指针，拼接拉链在锁外面完成
+struct RealtimeChunk
+{
+    InvertedList list;
+    std::shared_ptr<const RealtimeChunk> prev; //前一块，没有时为空
+};
+
+static const size_t kRealtimeChunkSize = 128;
+
+//在线删除的 jump_url 在 realtime_urls 中对应的文档id
+static const uint64_t kDeletedDocId = static_cast<uint64_t>(-1);
+
+//加载进来的一份索引：索引文件，以及在它之上在线新增和删除文档的实时段和删除位图
+//重新加载索引时构建一个新的快照整体替换掉旧的，快照由 shared_ptr 引用计数，
+//旧的快照在最后一个使用它的请求结束之后才释放(索引文件这时才 munmap)
+//新增和删除文档时持有 write_mutex，同时只有一个写操作；查询不需要 write_mutex，
+//只在取实时段的拉链时短暂地持有 realtime_mutex
+struct IndexSnapshot
+{
+    IndexSnapshot()
+        : generation(0)
+        , retired(false)
+        , realtime_doc_cnt(0)
+        , deleted_size(0)
+    {}
+
+    //文档数，已加载的文档数 + 实时段中的文档数(包含已经被删除的)
+    uint64_t DocCnt() const
+    {
+        return reader.doc_cnt() + realtime_doc_cnt.load(std::memory_order_acquire);
+    }
+
+    //实时段的文档长度表是提前分配好的，文档加入之后就不会再改变，不需要加锁
+    const DocLength& GetDocLength(uint32_t doc_id) const
+    {
+        if(doc_id < reader.doc_cnt())
+        {
+            return reader.doc_length(doc_id);
+        }
+        return realtime_lengths[doc_id - reader.doc_cnt()];
+    }
+
+    bool IsDeleted(uint64_t doc_id) const
+    {
+        if(doc_id >= deleted_size)
+        {
+            return false;
+        }
+        return (deleted[doc_id >> 6].load(std::memory_order_relaxed) >> (doc_id & 63)) & 1;
+    }
+
+    //在删除位图中做标记，需要在持有 write_mutex 的情况下调用
+    void MarkDeleted(uint64_t doc_id);
+
+    //jump_url 当前对应的(没有被删除的)文档，需要在持有 write_mutex 的情况下调用
+    bool FindUrl(const std::string& jump_url, uint64_t* doc_id) const;
+
+    //把一个文档的倒排追加到实时段的拉链中，需要在持有 write_mutex 的情况下调用
+    void AddRealtimePostings(const InvertedIndex& doc_inverted);
+
+    IndexReader reader; //加载进来的索引文件
+    //第几次加载的索引，从 1 开始，没有加载时为 0
+    uint64_t generation;
+
+    std::mutex write_mutex;
+    //已经被重新加载的索引替换掉，实时段已经转到新的快照中，不能再写，持有 write_mutex 时读写
+    bool retired;
+    //实时段的正排，按照实时段的容量提前分配好，realtime_docs[i] 的文档id为 reader.doc_cnt() + i
+    //前 realtime_doc_cnt 个是已经加入的文档，文档写好之后才增加 realtime_doc_cnt，读的时候不需要加锁
+    std::unique_ptr<std::unique_ptr<DocInfo>[]> realtime_docs;
+    std::atomic<uint64_t> realtime_doc_cnt;
+    //实时段的文档长度，加载的时候按照实时段的容量分配
+    std::unique_ptr<DocLength[]> realtime_lengths;
+    //实时段的倒排，关键词 => 拉链的最后一块，只有写操作会修改，修改时持有 realtime_mutex
+    mutable std::mutex realtime_mutex;
+    std::unordered_map<std::string, std::shared_ptr<const RealtimeChunk>> realtime_terms;
+    //在线新增或者删除过的 jump_url => 当前的文档id(被删除的为 kDeletedDocId)，只有写操作使用
+    //其他的 url 在索引文件的 url 表中查找
+    std::unordered_map<std::string, uint64_t> realtime_urls;
+    //删除位图，一个 bit 对应一个文档，加载的时候按照 正排大小 + 实时段容量 分配
+    std::unique_ptr<std::atomic<uint64_t>[]> deleted;
+    uint64_t deleted_size;
+};
 
 //索引模块核心类，和索引相关的全部操作都包含在这个类中
 //a）构建，raw_input 中的内容进行解析在内存中构建出索引结构（hash）
-//b）保存，把内存中的索引结构进行序列化，保存到磁盘文件当中
-//   （序列化就依赖了刚才的 index.proto）制作索引的可执行程序
-//   来调用哦给保存
-//c）加载，把磁盘上的索引问而建读取出来，反序列化，生成内存
-//   中的索引结构，搜索服务器
+//b）保存，把内存中的索引结构按照 index_file.h 中的格式写到磁盘文件当中
+//   制作索引的可执行程序来调用保存
+//c）加载，把磁盘上的索引文件 mmap 进来，不需要反序列化，搜索服务器
+//   (旧版本的 protobuf 格式的索引文件加载时在内存中转换成新格式)
 //d）反解，内存中的索引结果按照一定的格式打印出来，方便测试
 //e）查正排，给定文档id，获取到文档的详细信息
 //f）查倒排，给定关键词，获取到和关键词相关的文档列表
@@ -64,43 +167,228 @@ public:
     }
 
     //从raw_input 文件中读取数据，在内存中构建索引结构
-    bool Build(const std::string& input_path);
+    //thread_num > 1 时使用多线程构建，结果和单线程构建完全一致
+    bool Build(const std::string& input_path, int thread_num = 1);
+
+    //增量构建，先 Load 已有的索引，再把 input_path 中的新文档追加进来
+    bool BuildIncremental(const std::string& input_path, int thread_num = 1);
 
-    //把内存中的索引数据保存到磁盘上
+    //内存受限时使用的构建方式，倒排超出 mem_budget(字节) 之后写到 tmp_dir 下的临时文件中，
+    //最后多路归并直接写出索引文件 output_path，结果和 Build + Save 完全一样
+    //临时文件写失败时返回 false，临时文件在返回之前都会删掉
+    bool BuildExternal(const std::string& input_path, const std::string& output_path,
+                       int thread_num, size_t mem_budget, const std::string& tmp_dir);
+
+    //把内存中的索引数据保存到磁盘上，已经加载的索引和新构建的部分合并在一起写出
+    //先写到临时文件再 rename 过去，正在使用 ouput_path 的服务器不会读到写了一半的文件
     bool Save(const std::string& ouput_path);
 
-    //把磁盘上的文件加载到内存的索引结构中
+    //加载磁盘上的索引文件，服务器运行过程中可以再次调用(热加载)：
+    //新的索引在调用的线程中加载好之后原子地替换掉当前的快照，加载失败时继续使用当前的索引，
+    //正在处理的请求(在 SnapshotGuard 的范围内)继续使用旧的索引直到结束，
+    //之前在线新增和删除的文档在替换之前重放到新的索引上(文档id会变)，
+    //新的索引文件中已经有同样内容的文档时不再重复加入实时段
     bool Load(const std::string& index_path);
 
+    //在一个请求的处理过程中固定使用同一份索引，期间重新加载索引不影响这个请求，
+    //请求中用到的文档id、拉链和正排都来自同一个快照
+    //放在请求处理的开头，作用范围内本线程对 Index 的调用都使用这个快照
+    class SnapshotGuard
+    {
+    public:
+        explicit SnapshotGuard(const Index* index)
+            : snapshot_(index->snapshot())
+            , prev_(pinned_)
+        {
+            pinned_ = snapshot_.get();
+        }
+
+        ~SnapshotGuard()
+        {
+            pinned_ = prev_;
+        }
+
+    private:
+        std::shared_ptr<IndexSnapshot> snapshot_;
+        IndexSnapshot* prev_;
+
+        SnapshotGuard(const SnapshotGuard&);
+        SnapshotGuard& operator=(const SnapshotGuard&);
+    };
+
     //调试用的接口，把内存中的索引数据按照一定的格式打印到文件中
     bool Dump(const std::string& forward_dump_path, const std::string& inverted_dump_path);
 
-    //根据 doc_id 获取到文档详细信息
-    const DocInfo* GetDocInfo(uint64_t doc_id) const;
+    //根据 doc_id 获取到文档详细信息，文档不存在时返回 false
+    //doc 中的字段指向索引内部的数据，在 SnapshotGuard 的范围内有效
+    bool GetDocInfo(uint64_t doc_id, DocView* doc) const;
     
-    //根据关键词获取到 倒排拉链（包含一组doc_id）
-    const InvertedList* GetInvertedList(const std::string& key) const;
+    //根据关键词获取到 倒排拉链（包含一组doc_id），关键词不存在时返回 false
+    //在前缀压缩的有序词典中查找，posting_list 指向索引内部的数据，在 SnapshotGuard 的范围内有效
+    //positions 不为 NULL 时同时获取位置索引，索引文件中没有位置索引时为空
+    bool GetInvertedList(const std::string& key, PostingList* posting_list,
+                         PositionList* positions = NULL) const;
+
+    //词典是按照字典序排列的，可以顺序遍历一段范围内的关键词(只包含已加载的索引文件)
+    //按照字典序列出 [beg, end) 范围内的关键词，end 为空表示不限制，最多 max_cnt 个
+    void GetTermsInRange(const std::string& beg, const std::string& end, size_t max_cnt,
+                         std::vector<std::string>* terms) const;
+
+    //按照字典序列出以 prefix 开头的关键词，最多 max_cnt 个
+    void GetTermsWithPrefix(const std::string& prefix, size_t max_cnt,
+                            std::vector<std::string>* terms) const;
 
     //此处为了方便服务器进行分词，再提供一个函数
     void CutWordWithoutStopWord(const std::string& query, std::vector<std::string>* words);
 
+    //同上，offsets 为每个词在分词结果(包含暂停词)中的下标，和位置索引中的位置对应，短语查询使用
+    //分词结果放在所有线程共享的缓存中，重复的查询不需要再分词
+    void CutWordWithoutStopWord(const std::string& query, std::vector<std::string>* words,
+                                std::vector<uint32_t>* offsets);
+
+    //分词缓存，命中率统计用
+    const CutCache& cut_cache() const
+    {
+        return cut_cache_;
+    }
+
+    //实时段相关的接口，服务器运行过程中在线新增和删除文档
+    //新增的文档放在一个内存中的实时段里面，id 接在已加载的索引之后，
+    //被删除(或者被新版本替换)的文档在删除位图中做标记，查询时跳过
+    //以下接口都是线程安全的
+
+    //新增文档，jump_url 已经存在时用新文档替换掉旧文档
+    bool AddDocument(const std::string& jump_url, const std::string& title,
+                     const std::string& content, uint64_t* doc_id);
+
+    //删除 jump_url 对应的文档，文档不存在时返回 false
+    bool DeleteDocument(const std::string& jump_url);
+
+    //文档数，已加载的文档数 + 实时段中的文档数(包含已经被删除的)
+    uint64_t DocCnt() const;
+
+    //索引的版本，加载索引、新增和删除文档之后都会加1，
+    //版本不变时同样的查询得到的结果一定一样，查询结果的缓存用它判断是否失效
+    uint64_t version() const
+    {
+        return version_.load(std::memory_order_acquire);
+    }
+
+    //文档的长度，doc_id 必须是已经加载或者已经加入实时段的文档
+    //打分时每个文档都要调用，需要在 SnapshotGuard 的范围内调用，不再获取快照
+    const DocLength& GetDocLength(uint32_t doc_id) const
+    {
+        return pinned_->GetDocLength(doc_id);
+    }
+
+    //一组文档的长度，打分的时候一次取一个块的文档，同样需要在 SnapshotGuard 的范围内调用
+    void GetDocLengths(const uint32_t* doc_ids, size_t n, DocLength* lengths) const
+    {
+        for(size_t i = 0; i < n; ++i)
+        {
+            lengths[i] = pinned_->GetDocLength(doc_ids[i]);
+        }
+    }
+
+    //当前索引是第几次加载的，每次重新加载都会变，文档id只在同一次加载的索引中有效
+    //分片查询分两次请求(先取文档id，再取文档内容)时，用来确认两次使用的是同一份索引
+    uint64_t generation() const
+    {
+        return SnapshotRef(this)->generation;
+    }
+
+    //df 为包含查询词的文档数，构造这个词的打分器
+    void GetScorer(uint64_t df, Bm25Scorer* scorer) const;
+
+    //文档id的上限，已加载的文档数 + 实时段的容量
+    uint64_t DocIdLimit() const
+    {
+        return SnapshotRef(this)->deleted_size;
+    }
+
+    //文档是否已经被删除
+    bool IsDeleted(uint64_t doc_id) const
+    {
+        return SnapshotRef(this)->IsDeleted(doc_id);
+    }
+
+    //把实时段中关键词对应的倒排拉链追加到 inverted_list 中，没有时返回 false
+    //拉链的块是只读的，拷贝的时候不持有锁
+    bool GetRealtimeInvertedList(const std::string& key, InvertedList* inverted_list) const;
+
 private:
-    ForwardIndex forward_index_; //正排索引，一组DocInfo
-    InvertedIndex inverted_index_; //倒排索引，哈希unordered_map;
+    //本线程当前使用的快照，在 SnapshotGuard 的范围内直接使用固定的快照，
+    //否则持有一份当前快照的引用，保证调用过程中快照不会被释放
+    class SnapshotRef
+    {
+    public:
+        explicit SnapshotRef(const Index* index)
+            : snapshot_(pinned_)
+        {
+            if(snapshot_ == NULL)
+            {
+                holder_ = index->snapshot();
+                snapshot_ = holder_.get();
+            }
+        }
+
+        IndexSnapshot* operator->() const
+        {
+            return snapshot_;
+        }
+
+    private:
+        IndexSnapshot* snapshot_;
+        std::shared_ptr<IndexSnapshot> holder_;
+    };
+
+    //当前的快照，重新加载时整体替换，读写都通过 std::atomic_load/atomic_store
+    std::shared_ptr<IndexSnapshot> snapshot() const
+    {
+        return std::atomic_load(&snapshot_);
+    }
+
+    ForwardIndex forward_index_; //构建中的正排索引，一组DocInfo
+    InvertedIndex inverted_index_; //构建中的倒排索引，哈希unordered_map;
+    std::shared_ptr<IndexSnapshot> snapshot_; //加载进来的索引
+    //同时只能有一个加载在进行
+    std::mutex load_mutex_;
+    //加载的次数，持有 load_mutex_ 时修改
+    uint64_t load_cnt_;
     cppjieba::Jieba jieba_;
+    //多线程构建时，除 0 号线程(使用jieba_)之外每个线程使用的 jieba 对象
+    std::vector<std::unique_ptr<cppjieba::Jieba>> shard_jieba_;
     common::DicUtil stop_word_dict_;
+    CutCache cut_cache_;
+    std::atomic<uint64_t> version_;
 
+    //本线程在 SnapshotGuard 的范围内固定使用的快照，范围外为 NULL
+    static thread_local IndexSnapshot* pinned_;
     static Index* inst_;
 
-    const DocInfo* BuildForward(const std::string& line);
-    void BuildInverted(const DocInfo& doc_info);
-    void SortInverted();
-    void SplitTitle(const std::string& title, DocInfo* doc_info);
-    void SplitContent(const std::string& content, DocInfo* doc_info);
-    int CalcWeight(int title_cnt, int content_cnt);
-    static bool CmpWeight(const Weight& w1, const Weight& w2);
-    bool ConvertToProto(std::string* proto_data);
-    bool ConvertFromProto(const std::string& proto_data);
+    bool BuildParallel(const std::string& input_path, int thread_num);
+    void BuildLines(const std::vector<std::string>& lines, uint64_t first_doc_id, int thread_num);
+    void BuildShard(int shard_id, const std::vector<std::string>& lines, size_t beg, size_t end,
+                    uint64_t first_doc_id, DocInfo* docs, InvertedIndex* shard);
+    void MergeShards(std::vector<InvertedIndex>* shards);
+    size_t EstimateInvertedSize() const;
+    bool SpillRun(common::TmpDir* run_dir, std::vector<std::string>* run_paths);
+    bool MergeRuns(const std::vector<std::string>& run_paths, IndexWriter* writer);
+    bool BuildForward(const std::string& line, uint64_t doc_id, cppjieba::Jieba* jieba, DocInfo* doc_info);
+    void BuildInverted(const DocInfo& doc_info, InvertedIndex* inverted_index);
+    bool BuildDocInfo(uint64_t doc_id, const std::string& jump_url, const std::string& title,
+                      const std::string& content, cppjieba::Jieba* jieba, DocInfo* doc_info);
+    bool SplitTitle(const std::string& title, cppjieba::Jieba* jieba, DocInfo* doc_info);
+    bool SplitContent(const std::string& content, cppjieba::Jieba* jieba, DocInfo* doc_info);
+    static void ConvertKwdInfo(const std::string& key, const InvertedList& inverted_list,
+                               doc_index_proto::KwdInfo* kwd_info);
+    static void ToDocView(const DocInfo& doc_info, DocView* doc);
+    bool ConvertFromProto(const std::string& proto_data, std::string* index_data);
+    //在 snapshot 的实时段中新增和删除文档，需要在持有 snapshot->write_mutex 的情况下调用
+    bool AddToSnapshot(IndexSnapshot* snapshot, std::unique_ptr<DocInfo> doc_info, uint64_t* doc_id);
+    bool DeleteFromSnapshot(IndexSnapshot* snapshot, const std::string& jump_url);
+    //把 old_snapshot 上在线新增和删除的文档重放到新加载的 snapshot 上，两个快照的 write_mutex 都要持有
+    void ReplayRealtime(const IndexSnapshot& old_snapshot, IndexSnapshot* snapshot);
 
 };
 
@@ -1,9 +1,70 @@
+#include <fstream>
+#include <cstdio>
 #include <base/base.h>
 #include "index.h"
 
 
 DEFINE_string(input_path, "../data/tmp/raw_input", "raw_input 文件路径");
 DEFINE_string(output_path, "../data/output/index_file", "索引文件输出路径");
+DEFINE_int32(build_threads, 1, "构建索引使用的线程数，大于1时多线程构建");
+DEFINE_int32(build_mem_budget_mb, 0, "构建索引时倒排的内存预算(MB)，超出后写到临时文件中外部归并，0表示不限制");
+DEFINE_string(build_tmp_dir, "../data/tmp", "外部归并时临时文件的目录");
+DEFINE_string(base_index_path, "", "增量构建时已有的索引文件路径，input_path 中只包含新增的文档，为空表示全量构建");
+DEFINE_int32(shard_num, 1, "按照文档切分的分片数，大于1时输出 output_path.0 ~ output_path.(N-1)，每个分片由一个服务器加载");
+
+//全量构建一个索引文件，内存受限时边构建边写索引文件
+static bool BuildIndex(doc_index::Index* index, const std::string& input_path, const std::string& output_path)
+{
+    if(fLI::FLAGS_build_mem_budget_mb > 0)
+    {
+        return index->BuildExternal(input_path, output_path,
+                                    fLI::FLAGS_build_threads,
+                                    (size_t)fLI::FLAGS_build_mem_budget_mb << 20,
+                                    fLS::FLAGS_build_tmp_dir);
+    }
+    return index->Build(input_path, fLI::FLAGS_build_threads) && index->Save(output_path);
+}
+
+//按照 jump_url 把 input_path 中的文档分到 shard_num 个临时文件中，每个分片的文档保持原来的顺序
+//临时文件放在 tmp_dir 中，同时进行的多个构建不会互相覆盖，失败时由 tmp_dir 删除
+static bool SplitShards(const std::string& input_path, int shard_num, common::TmpDir* tmp_dir,
+                        std::vector<std::string>* shard_paths)
+{
+    std::ifstream file(input_path.c_str());
+    if(!file.is_open())
+    {
+        LOG(ERROR) << "open input failed! input_path:" << input_path;
+        return false;
+    }
+    std::vector<std::unique_ptr<std::ofstream>> outputs;
+    for(int i = 0; i < shard_num; ++i)
+    {
+        shard_paths->push_back(tmp_dir->NewFile("raw_input.shard" + std::to_string(i)));
+        outputs.emplace_back(new std::ofstream(shard_paths->back().c_str()));
+        if(!outputs.back()->is_open())
+        {
+            LOG(ERROR) << "open shard file failed! shard_path:" << shard_paths->back();
+            return false;
+        }
+    }
+    std::string line;
+    while(std::getline(file, line))
+    {
+        //每一行为 jump_url\3title\3content
+        size_t pos = line.find('\3');
+        common::StringPiece jump_url(line.data(), pos == std::string::npos ? line.size() : pos);
+        *outputs[common::StringUtil::ShardOf(jump_url, shard_num)] << line << "\n";
+    }
+    for(int i = 0; i < shard_num; ++i)
+    {
+        if(!outputs[i]->flush())
+        {
+            LOG(ERROR) << "write shard file failed! shard_path:" << (*shard_paths)[i];
+            return false;
+        }
+    }
+    return true;
+}
 
 int main(int argc, char* argv[]) 
 {
@@ -11,9 +72,51 @@ int main(int argc, char* argv[])
   	fLS::FLAGS_log_dir = "../log/"; 
     gflags::ParseCommandLineFlags(&argc, &argv, true);
 
+    if(fLI::FLAGS_shard_num > 1)
+    {
+        //文档切分成多个分片，每个分片是一个独立的索引文件，
+        //由各自的服务器加载，聚合服务器把查询发给所有的分片再合并结果
+        CHECK(fLS::FLAGS_base_index_path.empty()) << "sharded build does not support base_index_path";
+        //失败时直接返回，tmp_dir 析构时删除切分出来的临时文件
+        common::TmpDir tmp_dir;
+        if(!tmp_dir.Create(fLS::FLAGS_build_tmp_dir, "raw_input_shards_"))
+        {
+            PLOG(ERROR) << "create tmp dir failed! build_tmp_dir:" << fLS::FLAGS_build_tmp_dir;
+            return 1;
+        }
+        std::vector<std::string> shard_paths;
+        if(!SplitShards(fLS::FLAGS_input_path, fLI::FLAGS_shard_num, &tmp_dir, &shard_paths))
+        {
+            return 1;
+        }
+        for(int i = 0; i < fLI::FLAGS_shard_num; ++i)
+        {
+            //一个分片构建完就释放，同时只有一个分片在内存中
+            doc_index::Index shard_index;
+            if(!BuildIndex(&shard_index, shard_paths[i], fLS::FLAGS_output_path + "." + std::to_string(i)))
+            {
+                LOG(ERROR) << "build shard " << i << " failed";
+                return 1;
+            }
+            std::remove(shard_paths[i].c_str());
+            LOG(INFO) << "shard " << i << " done";
+        }
+        return 0;
+    }
+
     doc_index::Index* index = doc_index::Index::Instance();
-    CHECK(index->Build(fLS::FLAGS_input_path));
-    CHECK(index->Save(fLS::FLAGS_output_path));
+    if(!fLS::FLAGS_base_index_path.empty())
+    {
+        //增量构建，需要先把已有的索引加载进来
+        CHECK(fLI::FLAGS_build_mem_budget_mb == 0) << "incremental build does not support build_mem_budget_mb";
+        //已有的索引是 mmap 进来的，保存的时候不能覆盖它
+        CHECK(fLS::FLAGS_base_index_path != fLS::FLAGS_output_path) << "output_path must differ from base_index_path";
+        CHECK(index->Load(fLS::FLAGS_base_index_path));
+        CHECK(index->BuildIncremental(fLS::FLAGS_input_path, fLI::FLAGS_build_threads));
+        CHECK(index->Save(fLS::FLAGS_output_path));
+        return 0;
+    }
+    CHECK(BuildIndex(index, fLS::FLAGS_input_path, fLS::FLAGS_output_path));
     return 0;
 
 }
@@ -0,0 +1,771 @@
+#include "index_file.h"
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <glog/logging.h>
+#include <snappy.h>
+
+
+namespace doc_index
+{
+
+IndexWriter::IndexWriter(std::ostream* output)
+    : output_(output)
+    , pos_(0)
+    , docs_finished_(false)
+    , term_cnt_(0)
+{
+    //先占住文件头的位置，Finish 的时候再回填
+    memset(&header_, 0, sizeof(header_));
+    memcpy(header_.magic, kIndexFileMagicPrefix, sizeof(kIndexFileMagicPrefix));
+    header_.magic[6] = '0' + kIndexFileVersion / 10;
+    header_.magic[7] = '0' + kIndexFileVersion % 10;
+    Write(&header_, sizeof(header_));
+}
+
+void IndexWriter::Write(const void* data, size_t len)
+{
+    output_->write(static_cast<const char*>(data), len);
+    pos_ += len;
+}
+
+//补0到8字节对齐
+void IndexWriter::Align()
+{
+    static const char kZero[8] = {0};
+    if(pos_ % 8 != 0)
+    {
+        Write(kZero, 8 - pos_ % 8);
+    }
+}
+
+void IndexWriter::AddDoc(const DocView& doc)
+{
+    CHECK(!docs_finished_) << "AddDoc after AddTerm";
+    CHECK_EQ(doc.id, doc_locations_.size()) << "doc must be added in id order";
+    DocLocation location;
+    location.block = doc_block_offsets_.size();
+    location.offset = doc_block_.size();
+    doc_locations_.push_back(location);
+    doc_lengths_.push_back(doc.length);
+    UrlEntry url_entry = {common::StringPieceHash()(doc.jump_url), doc.id};
+    url_entries_.push_back(url_entry);
+    header_.total_title_len += doc.length.title_len;
+    header_.total_content_len += doc.length.content_len;
+    if(doc_lengths_.size() == 1 || doc.length.title_len < header_.min_title_len)
+    {
+        header_.min_title_len = doc.length.title_len;
+    }
+    if(doc_lengths_.size() == 1 || doc.length.content_len < header_.min_content_len)
+    {
+        header_.min_content_len = doc.length.content_len;
+    }
+    DocRecord record;
+    record.title_len = doc.title.size();
+    record.content_len = doc.content.size();
+    record.show_url_len = doc.show_url.size();
+    record.jump_url_len = doc.jump_url.size();
+    doc_block_.append(reinterpret_cast<const char*>(&record), sizeof(record));
+    doc_block_.append(doc.title.data(), doc.title.size());
+    doc_block_.append(doc.content.data(), doc.content.size());
+    doc_block_.append(doc.show_url.data(), doc.show_url.size());
+    doc_block_.append(doc.jump_url.data(), doc.jump_url.size());
+    //句子的起始位置在建索引的时候算好，生成描述时二分查找就可以了
+    common::StringUtil::SentenceStarts(doc.content, &sentence_starts_);
+    uint32_t sentence_cnt = sentence_starts_.size();
+    doc_block_.append(reinterpret_cast<const char*>(&sentence_cnt), sizeof(sentence_cnt));
+    doc_block_.append(reinterpret_cast<const char*>(sentence_starts_.data()),
+                      sentence_starts_.size() * sizeof(uint32_t));
+    uint32_t tokens_len = doc.content_tokens.size();
+    doc_block_.append(reinterpret_cast<const char*>(&tokens_len), sizeof(tokens_len));
+    doc_block_.append(doc.content_tokens.data(), doc.content_tokens.size());
+    if(doc_block_.size() >= kDocBlockSize)
+    {
+        FlushDocBlock();
+    }
+}
+
+//把当前的正排块压缩之后写出去
+void IndexWriter::FlushDocBlock()
+{
+    if(doc_block_.empty())
+    {
+        return;
+    }
+    doc_block_offsets_.push_back(pos_);
+    std::string compressed;
+    snappy::Compress(doc_block_.data(), doc_block_.size(), &compressed);
+    Write(compressed.data(), compressed.size());
+    doc_block_.clear();
+}
+
+//正排写完之后写正排位置表、块偏移表和文档长度表，后面就是倒排区了
+void IndexWriter::FinishDocs()
+{
+    if(docs_finished_)
+    {
+        return;
+    }
+    docs_finished_ = true;
+    FlushDocBlock();
+    doc_block_offsets_.push_back(pos_);
+    header_.doc_cnt = doc_locations_.size();
+    header_.doc_block_cnt = doc_block_offsets_.size() - 1;
+    Align();
+    header_.doc_locations_off = pos_;
+    Write(doc_locations_.data(), doc_locations_.size() * sizeof(DocLocation));
+    Align();
+    header_.doc_blocks_off = pos_;
+    Write(doc_block_offsets_.data(), doc_block_offsets_.size() * sizeof(uint64_t));
+    Align();
+    header_.doc_lengths_off = pos_;
+    Write(doc_lengths_.data(), doc_lengths_.size() * sizeof(DocLength));
+    Align();
+    header_.url_table_off = pos_;
+    std::sort(url_entries_.begin(), url_entries_.end(), [](const UrlEntry& e1, const UrlEntry& e2)
+    {
+        return e1.hash != e2.hash ? e1.hash < e2.hash : e1.doc_id < e2.doc_id;
+    });
+    Write(url_entries_.data(), url_entries_.size() * sizeof(UrlEntry));
+    std::string().swap(doc_block_);
+    std::vector<DocLocation>().swap(doc_locations_);
+    std::vector<uint64_t>().swap(doc_block_offsets_);
+    std::vector<DocLength>().swap(doc_lengths_);
+    std::vector<UrlEntry>().swap(url_entries_);
+}
+
+void IndexWriter::AddTerm(const common::StringPiece& term, const InvertedList& inverted_list)
+{
+    packed_.clear();
+    PostingList::Encode(inverted_list, &packed_);
+    packed_positions_.clear();
+    PositionList::Encode(inverted_list, &packed_positions_);
+    AddTerm(term, packed_, packed_positions_);
+}
+
+void IndexWriter::AddTerm(const common::StringPiece& term, const common::StringPiece& packed,
+                          const common::StringPiece& positions)
+{
+    FinishDocs();
+    CHECK(term_cnt_ == 0 || common::StringPiece(last_term_) < term)
+        << "term must be added in ascending order, term=" << term.ToString();
+    CHECK_LE(packed.size(), 0xFFFFFFFFULL) << "posting list too long, term=" << term.ToString();
+    CHECK_LE(positions.size(), 0xFFFFFFFFULL) << "position list too long, term=" << term.ToString();
+    //拉链中有 uint32_t 的数组，起始位置需要对齐
+    Align();
+    if(term_cnt_ % kTermBlockSize == 0)
+    {
+        //块内的第一个关键词完整保存
+        TermBlock block;
+        block.dict_off = term_dict_.size();
+        block.posting_off = pos_;
+        term_blocks_.push_back(block);
+        AppendVarint(term.size(), &term_dict_);
+        term_dict_.append(term.data(), term.size());
+    }
+    else
+    {
+        //只保存和前一个关键词不同的后缀
+        size_t shared = 0;
+        while(shared < last_term_.size() && shared < term.size() && last_term_[shared] == term[shared])
+        {
+            ++shared;
+        }
+        AppendVarint(shared, &term_dict_);
+        AppendVarint(term.size() - shared, &term_dict_);
+        term_dict_.append(term.data() + shared, term.size() - shared);
+    }
+    AppendVarint(packed.size(), &term_dict_);
+    AppendVarint(positions.size(), &term_dict_);
+    last_term_.assign(term.data(), term.size());
+    ++term_cnt_;
+    Write(packed.data(), packed.size());
+    Align();
+    Write(positions.data(), positions.size());
+}
+
+bool IndexWriter::Finish()
+{
+    FinishDocs();
+    Align();
+    header_.term_cnt = term_cnt_;
+    header_.term_blocks_off = pos_;
+    Write(term_blocks_.data(), term_blocks_.size() * sizeof(TermBlock));
+    header_.term_dict_off = pos_;
+    Write(term_dict_.data(), term_dict_.size());
+    header_.file_size = pos_;
+
+    //回到开头写文件头
+    output_->seekp(0);
+    output_->write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    output_->seekp(pos_);
+    output_->flush();
+    return output_->good();
+}
+
+std::shared_ptr<const std::string> DocBlockCache::Get(uint32_t block)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = blocks_.find(block);
+    if(it == blocks_.end())
+    {
+        return std::shared_ptr<const std::string>();
+    }
+    //移到表头
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->second;
+}
+
+void DocBlockCache::Put(uint32_t block, const std::shared_ptr<const std::string>& data)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(capacity_ == 0 || blocks_.find(block) != blocks_.end())
+    {
+        //不缓存，或者别的线程已经放进来了
+        return;
+    }
+    lru_.push_front(std::make_pair(block, data));
+    blocks_[block] = lru_.begin();
+    Shrink();
+}
+
+void DocBlockCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    blocks_.clear();
+}
+
+void DocBlockCache::set_capacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    Shrink();
+}
+
+//淘汰最久没有使用的块，需要在持有 mutex_ 的情况下调用
+void DocBlockCache::Shrink()
+{
+    while(lru_.size() > capacity_)
+    {
+        blocks_.erase(lru_.back().first);
+        lru_.pop_back();
+    }
+}
+
+IndexReader::IndexReader()
+    : data_(NULL)
+    , len_(0)
+    , mmap_addr_(NULL)
+    , header_(NULL)
+    , doc_locations_(NULL)
+    , doc_blocks_(NULL)
+    , doc_lengths_(NULL)
+    , url_table_(NULL)
+    , term_blocks_(NULL)
+    , term_dict_(NULL)
+    , doc_cache_(64)
+{}
+
+IndexReader::~IndexReader()
+{
+    Close();
+}
+
+void IndexReader::Close()
+{
+    if(mmap_addr_ != NULL)
+    {
+        munmap(mmap_addr_, len_);
+        mmap_addr_ = NULL;
+    }
+    std::string().swap(buffer_);
+    data_ = NULL;
+    len_ = 0;
+    header_ = NULL;
+    doc_locations_ = NULL;
+    doc_blocks_ = NULL;
+    doc_lengths_ = NULL;
+    url_table_ = NULL;
+    doc_cache_.Clear();
+    term_blocks_ = NULL;
+    term_dict_ = NULL;
+}
+
+bool IndexReader::IsIndexFile(const common::StringPiece& data)
+{
+    return data.size() >= sizeof(IndexFileHeader)
+           && memcmp(data.data(), kIndexFileMagicPrefix, sizeof(kIndexFileMagicPrefix)) == 0
+           && data[6] == '0' + kIndexFileVersion / 10 && data[7] == '0' + kIndexFileVersion % 10;
+}
+
+bool IndexReader::Open(const std::string& path)
+{
+    Close();
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(IndexFileHeader))
+    {
+        close(fd);
+        return false;
+    }
+    //只读的共享映射，数据在需要的时候由操作系统从页缓存中换入，
+    //多个进程加载同一个索引文件时共用一份物理内存
+    void* addr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(addr == MAP_FAILED)
+    {
+        PLOG(ERROR) << "mmap failed! path=" << path;
+        return false;
+    }
+    mmap_addr_ = addr;
+    data_ = static_cast<const char*>(addr);
+    len_ = st.st_size;
+    if(!Init())
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool IndexReader::OpenBuffer(std::string* buffer)
+{
+    Close();
+    buffer_.swap(*buffer);
+    data_ = buffer_.data();
+    len_ = buffer_.size();
+    if(!Init())
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+//带边界检查的 ReadVarint，超出 end 或者超过 5 个字节时返回 NULL，解码词典时使用
+static const char* ReadVarintChecked(const char* data, const char* end, uint32_t* value)
+{
+    uint32_t result = 0;
+    for(int shift = 0; shift < 35; shift += 7)
+    {
+        if(data >= end)
+        {
+            return NULL;
+        }
+        uint8_t byte = *data++;
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if((byte & 0x80) == 0)
+        {
+            *value = result;
+            return data;
+        }
+    }
+    return NULL;
+}
+
+//文件的内容不可信(可能是写坏了或者被截断的文件)，加载时只检查文件头和各个区域的位置，
+//不通过时加载失败，服务器继续使用之前的索引；这样加载不需要读取整个文件，启动时间和索引大小无关
+//词典在解码时检查，正排块的偏移和内容在解压和解析时检查，拉链的内容在查找关键词时检查头部，
+//不通过时只是这个关键词或者文档找不到
+bool IndexReader::Init()
+{
+    if(!IsIndexFile(common::StringPiece(data_, len_)))
+    {
+        return false;
+    }
+    header_ = reinterpret_cast<const IndexFileHeader*>(data_);
+    if(header_->file_size != len_)
+    {
+        LOG(ERROR) << "index file truncated! file_size=" << header_->file_size << " len=" << len_;
+        return false;
+    }
+    //DocLocation 中的块号只有32位
+    if(header_->doc_block_cnt >= 0xFFFFFFFFULL)
+    {
+        LOG(ERROR) << "index file corrupted! doc_block_cnt=" << header_->doc_block_cnt;
+        return false;
+    }
+    uint64_t term_block_cnt = header_->term_cnt / kTermBlockSize + (header_->term_cnt % kTermBlockSize != 0);
+    if(!CheckSection("doc_locations", header_->doc_locations_off, header_->doc_cnt, sizeof(DocLocation))
+       || !CheckSection("doc_blocks", header_->doc_blocks_off, header_->doc_block_cnt + 1, sizeof(uint64_t))
+       || !CheckSection("doc_lengths", header_->doc_lengths_off, header_->doc_cnt, sizeof(DocLength))
+       || !CheckSection("term_blocks", header_->term_blocks_off, term_block_cnt, sizeof(TermBlock))
+       || !CheckSection("term_dict", header_->term_dict_off, 0, 1)
+       || !CheckSection("url_table", header_->url_table_off, header_->doc_cnt, sizeof(UrlEntry)))
+    {
+        return false;
+    }
+    doc_locations_ = reinterpret_cast<const DocLocation*>(data_ + header_->doc_locations_off);
+    doc_blocks_ = reinterpret_cast<const uint64_t*>(data_ + header_->doc_blocks_off);
+    doc_lengths_ = reinterpret_cast<const DocLength*>(data_ + header_->doc_lengths_off);
+    term_blocks_ = reinterpret_cast<const TermBlock*>(data_ + header_->term_blocks_off);
+    term_dict_ = data_ + header_->term_dict_off;
+    url_table_ = reinterpret_cast<const UrlEntry*>(data_ + header_->url_table_off);
+    return true;
+}
+
+bool IndexReader::CheckSection(const char* name, uint64_t off, uint64_t cnt, size_t size) const
+{
+    if(off < sizeof(IndexFileHeader) || off > len_ || off % 8 != 0 || cnt > (len_ - off) / size)
+    {
+        LOG(ERROR) << "index file corrupted! section=" << name << " off=" << off << " cnt=" << cnt
+                   << " len=" << len_;
+        return false;
+    }
+    return true;
+}
+
+bool IndexReader::FindUrl(const common::StringPiece& jump_url, uint64_t* doc_id) const
+{
+    uint64_t hash = common::StringPieceHash()(jump_url);
+    const UrlEntry* end = url_table_ + doc_cnt();
+    const UrlEntry* it = std::lower_bound(url_table_, end, hash, [](const UrlEntry& entry, uint64_t hash)
+    {
+        return entry.hash < hash;
+    });
+    //哈希相同的文档按照id排序，从后往前找，返回id最大的那个
+    const UrlEntry* last = it;
+    while(last != end && last->hash == hash)
+    {
+        ++last;
+    }
+    DocView doc;
+    while(last != it)
+    {
+        --last;
+        if(GetDoc(last->doc_id, &doc) && doc.jump_url == jump_url)
+        {
+            *doc_id = last->doc_id;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool IndexReader::GetDoc(uint64_t doc_id, DocView* doc) const
+{
+    if(doc_id >= doc_cnt())
+    {
+        return false;
+    }
+    std::shared_ptr<const std::string> block = GetDocBlock(doc_locations_[doc_id].block);
+    if(!block)
+    {
+        return false;
+    }
+    return ParseDoc(doc_id, block, doc);
+}
+
+//解压之后的块的内容也不可信，每个字段都要在块的范围内
+bool IndexReader::ParseDoc(uint64_t doc_id, std::shared_ptr<const std::string> block, DocView* doc) const
+{
+    const DocLocation& location = doc_locations_[doc_id];
+    const char* p = block->data() + std::min<size_t>(location.offset, block->size());
+    const char* end = block->data() + block->size();
+    //p 后面是否还有 n 个字节
+    auto has = [&p, end](uint64_t n) { return n <= (uint64_t)(end - p); };
+    DocRecord record;
+    if(location.offset > block->size() || !has(sizeof(record)))
+    {
+        LOG(ERROR) << "doc record out of block! doc_id=" << doc_id;
+        return false;
+    }
+    memcpy(&record, p, sizeof(record));
+    p += sizeof(record);
+    if(!has((uint64_t)record.title_len + record.content_len + record.show_url_len + record.jump_url_len))
+    {
+        LOG(ERROR) << "doc record out of block! doc_id=" << doc_id;
+        return false;
+    }
+    doc->id = doc_id;
+    doc->title = common::StringPiece(p, record.title_len);
+    p += record.title_len;
+    doc->content = common::StringPiece(p, record.content_len);
+    p += record.content_len;
+    doc->show_url = common::StringPiece(p, record.show_url_len);
+    p += record.show_url_len;
+    doc->jump_url = common::StringPiece(p, record.jump_url_len);
+    p += record.jump_url_len;
+    uint32_t sentence_cnt = 0;
+    if(!has(sizeof(sentence_cnt)))
+    {
+        LOG(ERROR) << "doc record out of block! doc_id=" << doc_id;
+        return false;
+    }
+    memcpy(&sentence_cnt, p, sizeof(sentence_cnt));
+    p += sizeof(sentence_cnt);
+    if(!has((uint64_t)sentence_cnt * sizeof(uint32_t)))
+    {
+        LOG(ERROR) << "doc record out of block! doc_id=" << doc_id;
+        return false;
+    }
+    doc->sentence_starts = common::StringPiece(p, sentence_cnt * sizeof(uint32_t));
+    p += sentence_cnt * sizeof(uint32_t);
+    uint32_t tokens_len = 0;
+    if(!has(sizeof(tokens_len)))
+    {
+        LOG(ERROR) << "doc record out of block! doc_id=" << doc_id;
+        return false;
+    }
+    memcpy(&tokens_len, p, sizeof(tokens_len));
+    p += sizeof(tokens_len);
+    if(!has(tokens_len))
+    {
+        LOG(ERROR) << "doc record out of block! doc_id=" << doc_id;
+        return false;
+    }
+    doc->content_tokens = common::StringPiece(p, tokens_len);
+    doc->length = doc_lengths_[doc_id];
+    doc->block.swap(block);
+    return true;
+}
+
+int32_t DocView::SentenceBeg(int32_t first_pos) const
+{
+    if(sentence_starts.empty())
+    {
+        return common::StringUtil::FindSentenceBeg(content, first_pos);
+    }
+    //二分找到第一个 > first_pos + 1 的起始位置，它前面的那个就是所在的句子
+    const char* starts = sentence_starts.data();
+    size_t beg = 0;
+    size_t end = sentence_starts.size() / sizeof(uint32_t);
+    uint32_t target = first_pos + 1;
+    uint32_t start = 0;
+    while(beg < end)
+    {
+        size_t mid = beg + (end - beg) / 2;
+        memcpy(&start, starts + mid * sizeof(uint32_t), sizeof(start));
+        if(start <= target)
+        {
+            beg = mid + 1;
+        }
+        else
+        {
+            end = mid;
+        }
+    }
+    if(beg == 0)
+    {
+        return 0;
+    }
+    memcpy(&start, starts + (beg - 1) * sizeof(uint32_t), sizeof(start));
+    return start;
+}
+
+//获取解压之后的正排块，先在缓存中找，找不到再解压
+//多个线程同时解压同一个块时只是多做一次解压，结果是一样的
+std::shared_ptr<const std::string> IndexReader::GetDocBlock(uint32_t block) const
+{
+    std::shared_ptr<const std::string> data = doc_cache_.Get(block);
+    if(data)
+    {
+        return data;
+    }
+    std::shared_ptr<std::string> uncompressed(new std::string());
+    if(!UncompressDocBlock(block, uncompressed.get()))
+    {
+        return std::shared_ptr<const std::string>();
+    }
+    doc_cache_.Put(block, uncompressed);
+    return uncompressed;
+}
+
+bool IndexReader::UncompressDocBlock(uint32_t block, std::string* data) const
+{
+    //块号来自正排位置表，偏移来自正排块偏移表，都是在这里第一次使用的时候才检查
+    if(block >= header_->doc_block_cnt || doc_blocks_[block] > doc_blocks_[block + 1]
+       || doc_blocks_[block + 1] > len_)
+    {
+        LOG(ERROR) << "doc block out of range! block=" << block;
+        return false;
+    }
+    const char* compressed = data_ + doc_blocks_[block];
+    size_t compressed_len = doc_blocks_[block + 1] - doc_blocks_[block];
+    if(!snappy::Uncompress(compressed, compressed_len, data))
+    {
+        LOG(ERROR) << "Uncompress doc block failed! block=" << block;
+        return false;
+    }
+    return true;
+}
+
+bool IndexReader::BlockFirstTerm(size_t block, common::StringPiece* term) const
+{
+    uint64_t dict_off = term_blocks_[block].dict_off;
+    const char* end = data_ + len_;
+    if(dict_off >= (uint64_t)(end - term_dict_))
+    {
+        return false;
+    }
+    uint32_t len = 0;
+    const char* p = ReadVarintChecked(term_dict_ + dict_off, end, &len);
+    if(p == NULL || len > (size_t)(end - p))
+    {
+        return false;
+    }
+    *term = common::StringPiece(p, len);
+    return true;
+}
+
+size_t IndexReader::FindBlock(const common::StringPiece& key) const
+{
+    //二分找到第一个 第一个关键词 > key 的块，它前面的那个块就是要找的块
+    //损坏的块当作比 key 大，之后 TermIterator 解码这个块的时候会发现
+    size_t beg = 0;
+    size_t end = (term_cnt() + kTermBlockSize - 1) / kTermBlockSize;
+    while(beg < end)
+    {
+        size_t mid = beg + (end - beg) / 2;
+        common::StringPiece first;
+        if(BlockFirstTerm(mid, &first) && first.compare(key) <= 0)
+        {
+            beg = mid + 1;
+        }
+        else
+        {
+            end = mid;
+        }
+    }
+    return beg == 0 ? 0 : beg - 1;
+}
+
+bool IndexReader::FindTerm(const common::StringPiece& key, PostingList* posting_list,
+                           PositionList* positions) const
+{
+    TermIterator it(*this);
+    it.Seek(key);
+    if(!it.Valid() || common::StringPiece(it.term()) != key)
+    {
+        return false;
+    }
+    //拉链的范围在解码词典时已经检查过，这里再确认拉链头和块头都在拉链的范围内，
+    //并且块数和文档数一致(解码时每块最多 kPostingBlockSize 个文档)
+    PostingList list = it.posting_list();
+    if(list.len() < sizeof(PostingListHeader)
+       || list.block_cnt() > (list.len() - sizeof(PostingListHeader)) / sizeof(PostingBlock)
+       || list.block_cnt() != (list.size() + kPostingBlockSize - 1) / kPostingBlockSize)
+    {
+        LOG(ERROR) << "posting list corrupted! term=" << key.ToString();
+        return false;
+    }
+    *posting_list = list;
+    if(positions != NULL)
+    {
+        *positions = it.position_list();
+    }
+    return true;
+}
+
+TermIterator::TermIterator(const IndexReader& reader)
+    : reader_(reader)
+    , ordinal_(0)
+    , pos_(NULL)
+    , posting_off_(0)
+    , posting_len_(0)
+    , positions_len_(0)
+{
+    if(Valid())
+    {
+        LoadBlock(0);
+    }
+}
+
+void TermIterator::LoadBlock(size_t block)
+{
+    const TermBlock& term_block = reader_.term_blocks_[block];
+    ordinal_ = block * kTermBlockSize;
+    if(term_block.dict_off >= (uint64_t)(reader_.data_ + reader_.len_ - reader_.term_dict_))
+    {
+        SetCorrupted();
+        return;
+    }
+    pos_ = reader_.term_dict_ + term_block.dict_off;
+    posting_off_ = term_block.posting_off;
+    DecodeTerm(true);
+}
+
+//文件的内容不可信，解码时检查每个长度都不超出文件，拉链和位置索引都在倒排区
+//(文件头和正排之后、词典块索引之前)中，这样访问拉链时不会越界
+void TermIterator::DecodeTerm(bool first_in_block)
+{
+    const char* end = reader_.data_ + reader_.len_;
+    uint32_t shared = 0;
+    uint32_t len = 0;
+    if(!first_in_block)
+    {
+        pos_ = ReadVarintChecked(pos_, end, &shared);
+    }
+    if(pos_ != NULL)
+    {
+        pos_ = ReadVarintChecked(pos_, end, &len);
+    }
+    if(pos_ == NULL || shared > term_.size() || len > (size_t)(end - pos_))
+    {
+        SetCorrupted();
+        return;
+    }
+    term_.resize(shared);
+    term_.append(pos_, len);
+    pos_ += len;
+    pos_ = ReadVarintChecked(pos_, end, &posting_len_);
+    if(pos_ != NULL)
+    {
+        pos_ = ReadVarintChecked(pos_, end, &positions_len_);
+    }
+    uint64_t postings_end = reader_.header_->term_blocks_off;
+    if(pos_ == NULL || posting_off_ % 8 != 0 || posting_off_ > postings_end
+       || positions_off() > postings_end || positions_len_ > postings_end - positions_off())
+    {
+        SetCorrupted();
+    }
+}
+
+void TermIterator::SetCorrupted()
+{
+    LOG(ERROR) << "index file corrupted! bad term in dict, ordinal=" << ordinal_;
+    ordinal_ = reader_.term_cnt();
+    posting_off_ = 0;
+    posting_len_ = 0;
+    positions_len_ = 0;
+}
+
+void TermIterator::Next()
+{
+    ++ordinal_;
+    if(!Valid())
+    {
+        return;
+    }
+    if(ordinal_ % kTermBlockSize == 0)
+    {
+        LoadBlock(ordinal_ / kTermBlockSize);
+        return;
+    }
+    //拉链和位置索引是按照关键词的顺序依次写的，起始位置都8字节对齐
+    posting_off_ = (positions_off() + positions_len_ + 7) & ~(uint64_t)7;
+    DecodeTerm(false);
+}
+
+void TermIterator::Seek(const common::StringPiece& key)
+{
+    if(reader_.term_cnt() == 0)
+    {
+        return;
+    }
+    LoadBlock(reader_.FindBlock(key));
+    while(Valid() && common::StringPiece(term_) < key)
+    {
+        Next();
+    }
+}
+
+} //end doc_index
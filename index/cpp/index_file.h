@@ -0,0 +1,454 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <stdint.h>
+#include "posting_list.h"
+#include "../../common/util.hpp"
+
+
+namespace doc_index
+{
+
+//索引文件的格式(所有整数都是本机字节序，也就是小端)：
+//  IndexFileHeader
+//  正排区：每个文档一条记录，DocRecord + title + content + show_url + jump_url
+//          + uint32_t 句子数 + 正文中每个句子的起始位置(uint32_t 数组)
+//          + uint32_t 分词结果的字节数 + 正文的分词结果(编码见 ContentTokenIterator)，
+//          记录按照文档id的顺序拼接起来，每凑够 kDocBlockSize 字节为一块，每块用 snappy 单独压缩
+//  正排位置表：doc_cnt 个 DocLocation，记录每个文档在哪一块以及在解压之后的块中的偏移
+//  正排块偏移表：doc_block_cnt + 1 个 uint64_t，第 i 块压缩之后的数据为 [offsets[i], offsets[i+1])
+//  文档长度表：doc_cnt 个 DocLength，打分时需要每个文档的长度，不压缩，可以直接按照文档id访问
+//  url 表：doc_cnt 个 UrlEntry，按照 (jump_url 的哈希, 文档id) 排序，
+//          在线新增和删除文档时按照 jump_url 找到已有的文档，不需要扫描正排
+//  倒排区：每个关键词的压缩拉链(PostingList 的数据)，后面紧跟着它的位置索引(PositionList 的数据，
+//          没有构建位置索引时为空)，按照关键词的字典序排列，拉链和位置索引的起始位置都8字节对齐
+//  词典块索引：每 kTermBlockSize 个关键词一个 TermBlock
+//  词典：前缀压缩(front coding)的关键词，按照字典序排列，每 kTermBlockSize 个为一块，
+//        块内第一个关键词完整保存：varint(长度) + 关键词，
+//        后面的关键词只保存和前一个关键词不同的部分：varint(公共前缀长度) + varint(后缀长度) + 后缀，
+//        每个关键词后面跟着 varint(拉链长度) + varint(位置索引长度)，
+//        拉链的位置由前一个拉链的位置和长度推算出来
+//  查找关键词时先在块索引上二分找到所在的块，再在块内顺序解码，
+//  按照字典序排列也使得前缀查找和范围查找只需要顺序遍历一段连续的关键词
+//
+//加载时直接把整个文件 mmap 进来，查询的时候通过偏移直接访问文件中的数据，
+//不需要反序列化，也不需要拷贝，启动时间和索引大小基本无关。
+//正排只有最终返回的文档才需要读取，读取时只解压文档所在的块，最近解压的块放在一个小的缓存中
+//
+//文件头的 magic 为 "DOCIDX" + 两位十进制的版本号，只能加载和 kIndexFileVersion 相同的版本，
+//格式变化之后需要重新构建索引(protobuf 格式的旧索引文件在 Index::Load 中转换)
+
+static const char kIndexFileMagicPrefix[6] = {'D', 'O', 'C', 'I', 'D', 'X'};
+static const int kIndexFileVersion = 9;
+
+//正排每一块压缩前的大小(超过这个大小就开始新的一块)
+static const size_t kDocBlockSize = 32 * 1024;
+
+//词典中每一块包含的关键词个数
+static const size_t kTermBlockSize = 16;
+
+struct IndexFileHeader
+{
+    char magic[8];
+    uint64_t doc_cnt;
+    uint64_t term_cnt;
+    uint64_t doc_block_cnt;
+    uint64_t doc_locations_off; //正排位置表的位置
+    uint64_t doc_blocks_off;    //正排块偏移表的位置
+    uint64_t doc_lengths_off;   //文档长度表的位置
+    uint64_t term_blocks_off;   //词典块索引的位置
+    uint64_t term_dict_off;     //词典的位置
+    uint64_t file_size;
+    //所有文档的标题和正文的总长度，用来计算平均长度
+    uint64_t total_title_len;
+    uint64_t total_content_len;
+    //最短的标题和正文长度，用来估算得分的上限
+    uint32_t min_title_len;
+    uint32_t min_content_len;
+    uint64_t url_table_off;     //url 表的位置
+};
+
+//正排区中每个文档记录的头部，后面紧跟着各个字段的内容
+struct DocRecord
+{
+    uint32_t title_len;
+    uint32_t content_len;
+    uint32_t show_url_len;
+    uint32_t jump_url_len;
+};
+
+//文档在正排区中的位置
+struct DocLocation
+{
+    uint32_t block;  //所在的块
+    uint32_t offset; //记录在解压之后的块中的偏移
+};
+
+//文档的标题和正文的长度(分词之后的词数)
+struct DocLength
+{
+    uint32_t title_len;
+    uint32_t content_len;
+};
+
+//url 表中的一项
+struct UrlEntry
+{
+    uint64_t hash;   //jump_url 的哈希(common::StringPieceHash)
+    uint64_t doc_id;
+};
+
+//词典块索引中的一项
+struct TermBlock
+{
+    uint64_t dict_off;    //块的数据相对于词典起始位置的偏移
+    uint64_t posting_off; //块内第一个关键词的拉链在文件中的位置
+};
+
+//一个文档的只读视图，各个字段指向解压之后的正排块(或者实时段)中的数据
+//block 持有解压之后的块，保证 DocView 存在期间各个字段都是有效的
+struct DocView
+{
+    uint64_t id;
+    common::StringPiece title;
+    common::StringPiece content;
+    common::StringPiece show_url;
+    common::StringPiece jump_url;
+    DocLength length;
+    //正文中句子的起始位置表(uint32_t 数组，未对齐)，实时段中的文档为空
+    common::StringPiece sentence_starts;
+    //正文的分词结果，用 ContentTokenIterator 遍历
+    common::StringPiece content_tokens;
+    std::shared_ptr<const std::string> block;
+
+    //正文中 first_pos 所在的句子的起始位置，
+    //有句子起始位置表时二分查找，否则从 first_pos 往前扫描
+    int32_t SentenceBeg(int32_t first_pos) const;
+};
+
+//正文的分词结果，依次保存每个词的 varint(zigzag(beg - 前一个词的 beg))，
+//和 SplitContent 一样，每个词的 end 就是下一个词的 beg，最后一个词到正文的结尾
+//cppjieba 的 CutForSearch 会在长词前面先输出其中的短词，beg 不一定是递增的
+class ContentTokenIterator
+{
+public:
+    ContentTokenIterator(const common::StringPiece& data, size_t content_size)
+        : pos_(data.data())
+        , end_(data.data() + data.size())
+        , content_size_(content_size)
+        , valid_(true)
+        , has_next_(false)
+        , beg_(0)
+        , end_pos_(0)
+        , next_beg_(0)
+    {
+        ReadNextBeg();
+        Next();
+    }
+
+    bool Valid() const
+    {
+        return valid_;
+    }
+
+    void Next()
+    {
+        if(!has_next_)
+        {
+            valid_ = false;
+            return;
+        }
+        beg_ = next_beg_;
+        ReadNextBeg();
+        end_pos_ = has_next_ ? next_beg_ : (int32_t)content_size_;
+    }
+
+    int32_t beg() const
+    {
+        return beg_;
+    }
+
+    int32_t end() const
+    {
+        return end_pos_;
+    }
+
+    //追加一个词，last_beg 为前一个词的 beg，第一个词之前为0
+    static void Append(int32_t beg, int32_t* last_beg, std::string* data)
+    {
+        int32_t delta = beg - *last_beg;
+        AppendVarint(((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31), data);
+        *last_beg = beg;
+    }
+
+private:
+    void ReadNextBeg()
+    {
+        has_next_ = pos_ < end_;
+        if(has_next_)
+        {
+            uint32_t value = 0;
+            pos_ = ReadVarint(pos_, &value);
+            next_beg_ += (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+        }
+    }
+
+    const char* pos_;
+    const char* end_;
+    size_t content_size_;
+    bool valid_;
+    bool has_next_;
+    int32_t beg_;
+    int32_t end_pos_;
+    int32_t next_beg_;
+};
+
+//解压之后的正排块的缓存，按照最近使用的顺序淘汰，多线程共享
+//被淘汰的块如果还有 DocView 在使用，等到 DocView 析构之后才会释放
+class DocBlockCache
+{
+public:
+    explicit DocBlockCache(size_t capacity)
+        : capacity_(capacity)
+    {}
+
+    //不存在时返回空指针
+    std::shared_ptr<const std::string> Get(uint32_t block);
+
+    void Put(uint32_t block, const std::shared_ptr<const std::string>& data);
+
+    void Clear();
+
+    void set_capacity(size_t capacity);
+
+private:
+    typedef std::list<std::pair<uint32_t, std::shared_ptr<const std::string>>> LruList;
+
+    void Shrink();
+
+    std::mutex mutex_;
+    size_t capacity_;
+    LruList lru_; //表头是最近使用的块
+    std::unordered_map<uint32_t, LruList::iterator> blocks_;
+};
+
+//顺序写出索引文件：先按照文档id的顺序 AddDoc，再按照关键词的顺序 AddTerm，最后 Finish
+//只需要在内存中保留正排偏移表和词典，正排和拉链都是直接写到文件中的
+class IndexWriter
+{
+public:
+    //output 需要支持 seekp，Finish 的时候要回到开头写文件头
+    explicit IndexWriter(std::ostream* output);
+
+    void AddDoc(const DocView& doc);
+
+    //关键词必须严格升序，packed 为压缩之后的拉链，positions 为压缩之后的位置索引(可以为空)
+    void AddTerm(const common::StringPiece& term, const common::StringPiece& packed,
+                 const common::StringPiece& positions = common::StringPiece());
+
+    //把拉链压缩之后写出，拉链有位置时同时写出位置索引
+    void AddTerm(const common::StringPiece& term, const InvertedList& inverted_list);
+
+    bool Finish();
+
+private:
+    void Write(const void* data, size_t len);
+    void Align();
+    void FlushDocBlock();
+    void FinishDocs();
+
+    std::ostream* output_;
+    uint64_t pos_;
+    IndexFileHeader header_;
+    std::string doc_block_;             //当前还没有写出去的正排块
+    std::vector<DocLocation> doc_locations_;
+    std::vector<uint64_t> doc_block_offsets_;
+    std::vector<DocLength> doc_lengths_;
+    std::vector<UrlEntry> url_entries_;
+    bool docs_finished_;
+    uint64_t term_cnt_;
+    std::string last_term_;
+    std::vector<TermBlock> term_blocks_;
+    std::string term_dict_;
+    std::string packed_;
+    std::string packed_positions_;
+    std::vector<uint32_t> sentence_starts_;
+};
+
+class TermIterator;
+
+//索引文件的只读访问，数据可以是 mmap 进来的文件，也可以是内存中的一块数据
+class IndexReader
+{
+public:
+    IndexReader();
+    ~IndexReader();
+
+    //把索引文件 mmap 进来，文件不存在或者不是这种格式时返回 false
+    bool Open(const std::string& path);
+
+    //使用内存中的数据，buffer 中的内容会被交换过来
+    bool OpenBuffer(std::string* buffer);
+
+    void Close();
+
+    uint64_t doc_cnt() const
+    {
+        return header_ == NULL ? 0 : header_->doc_cnt;
+    }
+
+    uint64_t term_cnt() const
+    {
+        return header_ == NULL ? 0 : header_->term_cnt;
+    }
+
+    //读取文档，文档所在的块不在缓存中时需要解压
+    bool GetDoc(uint64_t doc_id, DocView* doc) const;
+
+    //按照 jump_url 查找文档，有多个文档的 url 相同时返回id最大的那个，不存在时返回 false
+    //需要读取候选文档的正排来确认 url，不是查询时使用的接口
+    bool FindUrl(const common::StringPiece& jump_url, uint64_t* doc_id) const;
+
+    //文档的长度，doc_id 必须小于 doc_cnt()
+    const DocLength& doc_length(uint64_t doc_id) const
+    {
+        return doc_lengths_[doc_id];
+    }
+
+    //标题和正文的平均长度
+    double avg_title_len() const
+    {
+        return doc_cnt() == 0 ? 0 : (double)header_->total_title_len / header_->doc_cnt;
+    }
+
+    double avg_content_len() const
+    {
+        return doc_cnt() == 0 ? 0 : (double)header_->total_content_len / header_->doc_cnt;
+    }
+
+    //最短的标题和正文长度
+    DocLength min_length() const
+    {
+        DocLength length = {0, 0};
+        if(doc_cnt() != 0)
+        {
+            length.title_len = header_->min_title_len;
+            length.content_len = header_->min_content_len;
+        }
+        return length;
+    }
+
+    //缓存的解压之后的正排块的个数
+    void set_doc_cache_capacity(size_t capacity)
+    {
+        doc_cache_.set_capacity(capacity);
+    }
+
+    //查找关键词，不存在时返回 false
+    //positions 不为 NULL 时同时返回位置索引，没有位置索引时为空
+    bool FindTerm(const common::StringPiece& key, PostingList* posting_list,
+                  PositionList* positions = NULL) const;
+
+    //文件格式是否能识别(magic 和版本号)
+    static bool IsIndexFile(const common::StringPiece& data);
+
+private:
+    friend class TermIterator;
+
+    //检查文件头和各个区域的位置，只读文件头，和索引的大小无关
+    bool Init();
+    //[off, off + cnt * size) 在文件中，并且 8 字节对齐
+    bool CheckSection(const char* name, uint64_t off, uint64_t cnt, size_t size) const;
+    //块的第一个关键词，块索引中的偏移或者关键词超出文件时返回 false
+    bool BlockFirstTerm(size_t block, common::StringPiece* term) const;
+    std::shared_ptr<const std::string> GetDocBlock(uint32_t block) const;
+    //解压第 block 块，不经过缓存
+    bool UncompressDocBlock(uint32_t block, std::string* data) const;
+    //从解压之后的块中解析出文档
+    bool ParseDoc(uint64_t doc_id, std::shared_ptr<const std::string> block, DocView* doc) const;
+    //最后一个第一个关键词 <= key 的块，所有块都比 key 大时返回0
+    size_t FindBlock(const common::StringPiece& key) const;
+
+    const char* data_;
+    size_t len_;
+    void* mmap_addr_;
+    std::string buffer_;
+    const IndexFileHeader* header_;
+    const DocLocation* doc_locations_;
+    const uint64_t* doc_blocks_;
+    const DocLength* doc_lengths_;
+    const UrlEntry* url_table_;
+    const TermBlock* term_blocks_;
+    const char* term_dict_;
+    mutable DocBlockCache doc_cache_;
+
+    IndexReader(const IndexReader&);
+    IndexReader& operator=(const IndexReader&);
+};
+
+//按照字典序遍历索引文件中的关键词
+class TermIterator
+{
+public:
+    //初始时指向第一个关键词
+    explicit TermIterator(const IndexReader& reader);
+
+    bool Valid() const
+    {
+        return ordinal_ < reader_.term_cnt();
+    }
+
+    void Next();
+
+    //跳到第一个 >= key 的关键词
+    void Seek(const common::StringPiece& key);
+
+    const std::string& term() const
+    {
+        return term_;
+    }
+
+    //关键词在词典中的序号
+    uint64_t ordinal() const
+    {
+        return ordinal_;
+    }
+
+    PostingList posting_list() const
+    {
+        return PostingList(reader_.data_ + posting_off_, posting_len_);
+    }
+
+    PositionList position_list() const
+    {
+        return PositionList(reader_.data_ + positions_off(), positions_len_);
+    }
+
+private:
+    //位置索引紧跟在拉链后面，8字节对齐
+    uint64_t positions_off() const
+    {
+        return (posting_off_ + posting_len_ + 7) & ~(uint64_t)7;
+    }
+
+    //词典的内容在解码的时候检查，数据损坏时记录日志，迭代器变成无效的
+    void LoadBlock(size_t block);
+    void DecodeTerm(bool first_in_block);
+    void SetCorrupted();
+
+    const IndexReader& reader_;
+    uint64_t ordinal_;
+    const char* pos_;       //下一个关键词在词典中的位置
+    std::string term_;
+    uint64_t posting_off_;
+    uint32_t posting_len_;
+    uint32_t positions_len_;
+};
+
+} //end doc_index
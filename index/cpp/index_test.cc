@@ -0,0 +1,492 @@
+//索引模块的单元测试，不依赖测试框架：每个测试是一个函数，检查不通过时 CHECK 直接退出
+//make test 编译并运行，全部通过时输出 ALL PASSED
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <glog/logging.h>
+#include "posting_list.h"
+#include "index_file.h"
+
+
+namespace doc_index
+{
+
+//生成一个随机的拉链，文档id严格递增，gap 为相邻文档id的最大差值
+static void RandomList(std::mt19937* rng, size_t n, uint32_t gap, bool with_positions, InvertedList* list)
+{
+    list->clear();
+    uint32_t doc_id = (*rng)() % gap;
+    std::vector<uint32_t> positions;
+    for(size_t i = 0; i < n; ++i)
+    {
+        Posting posting;
+        posting.doc_id = doc_id;
+        posting.title_tf = (*rng)() % 4;
+        //偶尔出现词频的上限，测试最大的bit位宽
+        posting.content_tf = (*rng)() % 16 == 0 ? kMaxTf : (*rng)() % 100 + 1;
+        //没有出现在正文中的词 first_pos 为 -1
+        posting.first_pos = (*rng)() % 8 == 0 ? -1 : (*rng)() % 100000;
+        if(with_positions)
+        {
+            positions.clear();
+            uint32_t pos = (*rng)() % 50;
+            for(size_t k = (*rng)() % 5 + 1; k > 0; --k)
+            {
+                positions.push_back(pos);
+                pos += (*rng)() % 3000 + 1;
+            }
+            list->push_back(posting, positions.data(), positions.size());
+        }
+        else
+        {
+            list->push_back(posting);
+        }
+        doc_id += (*rng)() % gap + 1;
+    }
+}
+
+static void CheckSameList(const InvertedList& expected, const InvertedList& actual)
+{
+    CHECK_EQ(expected.size(), actual.size());
+    for(size_t i = 0; i < expected.size(); ++i)
+    {
+        CHECK_EQ(expected.doc_ids[i], actual.doc_ids[i]) << "i=" << i;
+        CHECK_EQ(expected.title_tf[i], actual.title_tf[i]) << "i=" << i;
+        CHECK_EQ(expected.content_tf[i], actual.content_tf[i]) << "i=" << i;
+        CHECK_EQ(expected.first_pos[i], actual.first_pos[i]) << "i=" << i;
+    }
+}
+
+//压缩之后解压和原来的拉链完全一样，包括整块 bit 打包、最后一块 varint 和块边界上的长度
+static void TestPostingListRoundTrip()
+{
+    std::mt19937 rng(6);
+    const size_t sizes[] = {0, 1, 127, 128, 129, 255, 256, 1000, 5000};
+    //差值很小(bit位宽很小)和很大(接近32位)的拉链都要覆盖
+    const uint32_t gaps[] = {1, 7, 1000, 1 << 20};
+    for(size_t n : sizes)
+    {
+        for(uint32_t gap : gaps)
+        {
+            if((uint64_t)n * gap >= 0xFFFFFFFFULL)
+            {
+                continue;
+            }
+            InvertedList list;
+            RandomList(&rng, n, gap, false, &list);
+            std::string data;
+            PostingList::Encode(list, &data);
+            PostingList posting_list(data.data(), data.size());
+            CHECK_EQ(posting_list.size(), n);
+            CHECK_EQ(posting_list.block_cnt(), (n + kPostingBlockSize - 1) / kPostingBlockSize);
+            InvertedList decoded;
+            posting_list.Decode(&decoded);
+            CheckSameList(list, decoded);
+
+            //块头中的 last_doc_id 就是块中最后一个文档
+            for(size_t b = 0; b < posting_list.block_cnt(); ++b)
+            {
+                size_t last = std::min(n, (b + 1) * kPostingBlockSize) - 1;
+                CHECK_EQ(posting_list.block(b).last_doc_id, list.doc_ids[last]);
+            }
+        }
+    }
+    std::cout << "TestPostingListRoundTrip passed" << std::endl;
+}
+
+//PostingIterator 顺序遍历和 SkipTo 的结果和在原始拉链上二分查找一样
+static void TestPostingIteratorSkipTo()
+{
+    std::mt19937 rng(7);
+    InvertedList list;
+    RandomList(&rng, 3000, 50, false, &list);
+    std::string data;
+    PostingList::Encode(list, &data);
+    PostingList posting_list(data.data(), data.size());
+
+    size_t i = 0;
+    for(PostingIterator it(posting_list); it.Valid(); it.Next(), ++i)
+    {
+        CHECK_EQ(it.doc_id(), list.doc_ids[i]);
+        CHECK_EQ(it.ordinal(), i);
+        CHECK_EQ(it.first_pos(), list.first_pos[i]);
+    }
+    CHECK_EQ(i, list.size());
+
+    for(int round = 0; round < 100; ++round)
+    {
+        PostingIterator it(posting_list);
+        uint32_t target = 0;
+        while(true)
+        {
+            target += rng() % 2000;
+            it.SkipTo(target);
+            auto expected = std::lower_bound(list.doc_ids.begin(), list.doc_ids.end(), target);
+            if(expected == list.doc_ids.end())
+            {
+                CHECK(!it.Valid());
+                break;
+            }
+            CHECK(it.Valid());
+            CHECK_EQ(it.doc_id(), *expected);
+            CHECK_EQ(it.ordinal(), (size_t)(expected - list.doc_ids.begin()));
+        }
+    }
+    std::cout << "TestPostingIteratorSkipTo passed" << std::endl;
+}
+
+//位置索引整体解压和按照下标取单个文档的位置，结果都和原来一样
+static void TestPositionListRoundTrip()
+{
+    std::mt19937 rng(8);
+    const size_t sizes[] = {1, 127, 128, 129, 1000};
+    for(size_t n : sizes)
+    {
+        InvertedList list;
+        RandomList(&rng, n, 10, true, &list);
+        CHECK(list.has_positions());
+        std::string data;
+        PositionList::Encode(list, &data);
+        PositionList positions(data.data(), data.size());
+        CHECK(!positions.empty());
+
+        InvertedList decoded(list);
+        positions.Decode(&decoded);
+        CHECK(decoded.positions == list.positions);
+        CHECK(decoded.position_ends == list.position_ends);
+
+        std::vector<uint32_t> doc_positions;
+        for(size_t i = 0; i < n; ++i)
+        {
+            positions.Get(i, &doc_positions);
+            std::vector<uint32_t> expected(list.positions.begin() + list.position_beg(i),
+                                           list.positions.begin() + list.position_ends[i]);
+            CHECK(doc_positions == expected) << "i=" << i;
+        }
+    }
+
+    //没有位置的拉链不写出任何数据
+    InvertedList list;
+    RandomList(&rng, 10, 10, false, &list);
+    std::string data;
+    PositionList::Encode(list, &data);
+    CHECK(data.empty());
+    std::cout << "TestPositionListRoundTrip passed" << std::endl;
+}
+
+//用 IndexWriter 在内存中写出一个索引文件，再用 reader 打开
+static void BuildIndexFile(const std::vector<DocView>& docs, const std::vector<std::string>& terms,
+                           const std::vector<InvertedList>& lists, IndexReader* reader)
+{
+    std::stringstream output;
+    IndexWriter writer(&output);
+    for(const auto& doc : docs)
+    {
+        writer.AddDoc(doc);
+    }
+    for(size_t i = 0; i < terms.size(); ++i)
+    {
+        writer.AddTerm(terms[i], lists[i]);
+    }
+    CHECK(writer.Finish());
+    std::string data = output.str();
+    CHECK(reader->OpenBuffer(&data));
+}
+
+//一组有很多公共前缀的关键词(前缀压缩)，个数不是 kTermBlockSize 的整数倍，升序
+static void RandomTerms(std::mt19937* rng, size_t n, std::vector<std::string>* terms)
+{
+    const char* prefixes[] = {"a", "ab", "abc", "boost", "boost_asio", "\xe4\xb8\xad\xe6\x96\x87", "z"};
+    terms->clear();
+    while(terms->size() < n)
+    {
+        std::string term = prefixes[(*rng)() % 7];
+        for(size_t k = (*rng)() % 4; k > 0; --k)
+        {
+            term.push_back('a' + (*rng)() % 26);
+        }
+        terms->push_back(term);
+        std::sort(terms->begin(), terms->end());
+        terms->erase(std::unique(terms->begin(), terms->end()), terms->end());
+    }
+}
+
+//词典中每个关键词都能找到，拉链和位置索引和写进去的一样；不在词典中的关键词都找不到
+static void TestFindTerm()
+{
+    std::mt19937 rng(9);
+    std::vector<std::string> terms;
+    RandomTerms(&rng, 16 * 12 + 5, &terms);
+    std::vector<InvertedList> lists(terms.size());
+    for(auto& list : lists)
+    {
+        RandomList(&rng, rng() % 300 + 1, 20, true, &list);
+    }
+    IndexReader reader;
+    BuildIndexFile(std::vector<DocView>(), terms, lists, &reader);
+    CHECK_EQ(reader.term_cnt(), terms.size());
+
+    for(size_t i = 0; i < terms.size(); ++i)
+    {
+        PostingList posting_list;
+        PositionList positions;
+        CHECK(reader.FindTerm(terms[i], &posting_list, &positions)) << terms[i];
+        InvertedList decoded;
+        posting_list.Decode(&decoded);
+        CheckSameList(lists[i], decoded);
+        positions.Decode(&decoded);
+        CHECK(decoded.positions == lists[i].positions) << terms[i];
+        CHECK(decoded.position_ends == lists[i].position_ends) << terms[i];
+    }
+
+    //关键词的前缀、后面多一个字符、比所有关键词都小或者都大的，不在词典中时都找不到
+    std::vector<std::string> misses = {"", "\x01", "zzzzzzzz", "\xff"};
+    for(const auto& term : terms)
+    {
+        misses.push_back(term.substr(0, term.size() - 1));
+        misses.push_back(term + "0");
+        misses.push_back(term + "\xff");
+    }
+    size_t miss_cnt = 0;
+    for(const auto& key : misses)
+    {
+        if(std::binary_search(terms.begin(), terms.end(), key))
+        {
+            continue;
+        }
+        PostingList posting_list;
+        CHECK(!reader.FindTerm(key, &posting_list)) << key;
+        ++miss_cnt;
+    }
+    CHECK_GT(miss_cnt, terms.size());
+    std::cout << "TestFindTerm passed" << std::endl;
+}
+
+//TermIterator 按照字典序遍历所有的关键词，Seek 跳到第一个 >= key 的关键词
+static void TestTermIterator()
+{
+    std::mt19937 rng(10);
+    std::vector<std::string> terms;
+    RandomTerms(&rng, 16 * 5 + 3, &terms);
+    std::vector<InvertedList> lists(terms.size());
+    for(auto& list : lists)
+    {
+        RandomList(&rng, rng() % 200 + 1, 20, true, &list);
+    }
+    IndexReader reader;
+    BuildIndexFile(std::vector<DocView>(), terms, lists, &reader);
+
+    size_t i = 0;
+    for(TermIterator it(reader); it.Valid(); it.Next(), ++i)
+    {
+        CHECK_LT(i, terms.size());
+        CHECK_EQ(it.term(), terms[i]);
+        CHECK_EQ(it.ordinal(), i);
+        CHECK_EQ(it.posting_list().size(), lists[i].size());
+    }
+    CHECK_EQ(i, terms.size());
+
+    std::vector<std::string> keys = {"", "\x01", "zzzzzzzz", "\xff"};
+    for(const auto& term : terms)
+    {
+        keys.push_back(term);
+        keys.push_back(term.substr(0, term.size() - 1));
+        keys.push_back(term + "0");
+    }
+    for(const auto& key : keys)
+    {
+        TermIterator it(reader);
+        it.Seek(key);
+        auto expected = std::lower_bound(terms.begin(), terms.end(), key);
+        if(expected == terms.end())
+        {
+            CHECK(!it.Valid()) << key;
+            continue;
+        }
+        CHECK(it.Valid()) << key;
+        CHECK_EQ(it.term(), *expected);
+        CHECK_EQ(it.ordinal(), (uint64_t)(expected - terms.begin()));
+        //Seek 之后可以接着往后遍历
+        it.Next();
+        if(expected + 1 == terms.end())
+        {
+            CHECK(!it.Valid());
+        }
+        else
+        {
+            CHECK_EQ(it.term(), *(expected + 1));
+        }
+    }
+
+    //空词典
+    IndexReader empty;
+    BuildIndexFile(std::vector<DocView>(), std::vector<std::string>(), std::vector<InvertedList>(), &empty);
+    TermIterator it(empty);
+    CHECK(!it.Valid());
+    it.Seek("a");
+    CHECK(!it.Valid());
+    PostingList posting_list;
+    CHECK(!empty.FindTerm("a", &posting_list));
+    std::cout << "TestTermIterator passed" << std::endl;
+}
+
+//随机的文档，正文中带有句子的结束标志，文档要足够多，正排分成好几块
+struct TestDocs
+{
+    std::vector<std::string> titles;
+    std::vector<std::string> contents;
+    std::vector<std::string> urls;
+    std::vector<DocView> docs;
+};
+
+static void RandomDocs(std::mt19937* rng, size_t n, TestDocs* test_docs)
+{
+    const char chars[] = "abc xyz;,?!. ";
+    test_docs->titles.resize(n);
+    test_docs->contents.resize(n);
+    test_docs->urls.resize(n);
+    test_docs->docs.resize(n);
+    for(size_t i = 0; i < n; ++i)
+    {
+        std::string& title = test_docs->titles[i];
+        std::string& content = test_docs->contents[i];
+        title.clear();
+        content.clear();
+        for(size_t k = (*rng)() % 30; k > 0; --k)
+        {
+            title.push_back(chars[(*rng)() % (sizeof(chars) - 1)]);
+        }
+        for(size_t k = (*rng)() % 2000; k > 0; --k)
+        {
+            content.push_back(chars[(*rng)() % (sizeof(chars) - 1)]);
+        }
+        test_docs->urls[i] = "http://www.test.com/" + std::to_string(i) + ".html";
+        DocView& doc = test_docs->docs[i];
+        doc.id = i;
+        doc.title = title;
+        doc.content = content;
+        doc.show_url = test_docs->urls[i];
+        doc.jump_url = test_docs->urls[i];
+        doc.length.title_len = (*rng)() % 50 + 1;
+        doc.length.content_len = (*rng)() % 5000 + 3;
+    }
+}
+
+//正排和文档长度表写进去再读出来不变，平均长度和最短长度是所有文档的统计
+static void TestDocRoundTrip()
+{
+    std::mt19937 rng(14);
+    TestDocs test_docs;
+    RandomDocs(&rng, 700, &test_docs);
+    const std::vector<DocView>& docs = test_docs.docs;
+    IndexReader reader;
+    BuildIndexFile(docs, std::vector<std::string>(), std::vector<InvertedList>(), &reader);
+    CHECK_EQ(reader.doc_cnt(), docs.size());
+
+    uint64_t total_title_len = 0;
+    uint64_t total_content_len = 0;
+    DocLength min_length = docs[0].length;
+    for(const auto& doc : docs)
+    {
+        const DocLength& length = reader.doc_length(doc.id);
+        CHECK_EQ(length.title_len, doc.length.title_len);
+        CHECK_EQ(length.content_len, doc.length.content_len);
+        total_title_len += doc.length.title_len;
+        total_content_len += doc.length.content_len;
+        min_length.title_len = std::min(min_length.title_len, doc.length.title_len);
+        min_length.content_len = std::min(min_length.content_len, doc.length.content_len);
+
+        DocView read;
+        CHECK(reader.GetDoc(doc.id, &read));
+        CHECK_EQ(read.id, doc.id);
+        CHECK(read.title == doc.title);
+        CHECK(read.content == doc.content);
+        CHECK(read.show_url == doc.show_url);
+        CHECK(read.jump_url == doc.jump_url);
+        CHECK_EQ(read.length.title_len, doc.length.title_len);
+        CHECK_EQ(read.length.content_len, doc.length.content_len);
+        uint64_t doc_id = 0;
+        CHECK(reader.FindUrl(doc.jump_url, &doc_id));
+        CHECK_EQ(doc_id, doc.id);
+    }
+    CHECK_EQ(reader.avg_title_len(), (double)total_title_len / docs.size());
+    CHECK_EQ(reader.avg_content_len(), (double)total_content_len / docs.size());
+    CHECK_EQ(reader.min_length().title_len, min_length.title_len);
+    CHECK_EQ(reader.min_length().content_len, min_length.content_len);
+
+    DocView read;
+    CHECK(!reader.GetDoc(docs.size(), &read));
+    uint64_t doc_id = 0;
+    CHECK(!reader.FindUrl("http://www.test.com/none.html", &doc_id));
+
+    //没有文档时统计信息都是0
+    IndexReader empty;
+    BuildIndexFile(std::vector<DocView>(), std::vector<std::string>(), std::vector<InvertedList>(), &empty);
+    CHECK_EQ(empty.doc_cnt(), 0u);
+    CHECK_EQ(empty.avg_title_len(), 0);
+    CHECK_EQ(empty.avg_content_len(), 0);
+    CHECK_EQ(empty.min_length().title_len, 0u);
+    CHECK_EQ(empty.min_length().content_len, 0u);
+    std::cout << "TestDocRoundTrip passed" << std::endl;
+}
+
+//用句子起始位置表二分查找的结果和从 first_pos 往前扫描的结果一样
+static void TestSentenceBeg()
+{
+    std::mt19937 rng(18);
+    TestDocs test_docs;
+    RandomDocs(&rng, 300, &test_docs);
+    //没有结束标志的正文，还有 ". " 跨过正文结尾的情况
+    test_docs.contents[1] = "abc xyz abc";
+    test_docs.contents[2] = "abc.";
+    test_docs.contents[3] = ". . ..  ,;";
+    for(size_t i = 1; i <= 3; ++i)
+    {
+        test_docs.docs[i].content = test_docs.contents[i];
+    }
+    IndexReader reader;
+    BuildIndexFile(test_docs.docs, std::vector<std::string>(), std::vector<InvertedList>(), &reader);
+
+    size_t table_cnt = 0;
+    for(const auto& doc : test_docs.docs)
+    {
+        DocView read;
+        CHECK(reader.GetDoc(doc.id, &read));
+        if(!read.sentence_starts.empty())
+        {
+            ++table_cnt;
+        }
+        //实时段中的文档没有句子起始位置表
+        DocView scan = read;
+        scan.sentence_starts = common::StringPiece();
+        for(int32_t pos = 0; pos < (int32_t)doc.content.size(); ++pos)
+        {
+            int32_t expected = common::StringUtil::FindSentenceBeg(doc.content, pos);
+            CHECK_EQ(read.SentenceBeg(pos), expected) << doc.id << " " << pos;
+            CHECK_EQ(scan.SentenceBeg(pos), expected) << doc.id << " " << pos;
+        }
+    }
+    CHECK_GT(table_cnt, test_docs.docs.size() / 2);
+    std::cout << "TestSentenceBeg passed" << std::endl;
+}
+
+} //end doc_index
+
+
+int main(int argc, char* argv[])
+{
+    google::InitGoogleLogging(argv[0]);
+    (void) argc;
+    doc_index::TestPostingListRoundTrip();
+    doc_index::TestPostingIteratorSkipTo();
+    doc_index::TestPositionListRoundTrip();
+    doc_index::TestFindTerm();
+    doc_index::TestTermIterator();
+    doc_index::TestDocRoundTrip();
+    doc_index::TestSentenceBeg();
+    std::cout << "ALL PASSED" << std::endl;
+    return 0;
+}
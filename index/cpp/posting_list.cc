@@ -0,0 +1,449 @@
+#include "posting_list.h"
+#include <algorithm>
+#include <cstring>
+#include <glog/logging.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+namespace doc_index
+{
+
+//表示 value 需要的bit位数
+static uint8_t BitWidth(uint32_t value)
+{
+    uint8_t bits = 0;
+    while(value != 0)
+    {
+        ++bits;
+        value >>= 1;
+    }
+    return bits;
+}
+
+static uint32_t BitMask(uint8_t bits)
+{
+    return bits >= 32 ? 0xFFFFFFFF : (1U << bits) - 1;
+}
+
+//4路交错的bit打包，values 一共 kPostingBlockSize 个，结果为 4 * bits 个32位字
+//第 i 个数放在第 i % 4 路中第 i / 4 个位置
+static void PackBlock(const uint32_t* values, uint8_t bits, std::string* data)
+{
+    if(bits == 0)
+    {
+        //所有的数都是0，不需要保存
+        return;
+    }
+    std::vector<uint32_t> words(4 * bits, 0);
+    for(size_t i = 0; i < kPostingBlockSize; ++i)
+    {
+        size_t lane = i & 3;
+        size_t bit_pos = (i >> 2) * bits;
+        size_t word = bit_pos >> 5;
+        size_t shift = bit_pos & 31;
+        words[4 * word + lane] |= values[i] << shift;
+        if(shift + bits > 32)
+        {
+            words[4 * (word + 1) + lane] |= values[i] >> (32 - shift);
+        }
+    }
+    data->append(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint32_t));
+}
+
+//PackBlock 的逆过程，返回解压之后的数据的末尾位置
+static const char* UnpackBlock(const char* data, uint8_t bits, uint32_t* values)
+{
+    if(bits == 0)
+    {
+        memset(values, 0, kPostingBlockSize * sizeof(uint32_t));
+        return data;
+    }
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(data);
+#ifdef __SSE2__
+    //4路的数据同时处理，每次解出相邻的4个数
+    const __m128i* in = reinterpret_cast<const __m128i*>(words);
+    __m128i* out = reinterpret_cast<__m128i*>(values);
+    const __m128i mask = _mm_set1_epi32(BitMask(bits));
+    for(size_t k = 0; k < kPostingBlockSize / 4; ++k)
+    {
+        size_t bit_pos = k * bits;
+        size_t word = bit_pos >> 5;
+        size_t shift = bit_pos & 31;
+        __m128i v = _mm_srl_epi32(_mm_loadu_si128(in + word), _mm_cvtsi32_si128(shift));
+        if(shift + bits > 32)
+        {
+            __m128i high = _mm_loadu_si128(in + word + 1);
+            v = _mm_or_si128(v, _mm_sll_epi32(high, _mm_cvtsi32_si128(32 - shift)));
+        }
+        _mm_storeu_si128(out + k, _mm_and_si128(v, mask));
+    }
+#else
+    const uint32_t mask = BitMask(bits);
+    for(size_t i = 0; i < kPostingBlockSize; ++i)
+    {
+        size_t lane = i & 3;
+        size_t bit_pos = (i >> 2) * bits;
+        size_t word = bit_pos >> 5;
+        size_t shift = bit_pos & 31;
+        uint32_t v = words[4 * word + lane] >> shift;
+        if(shift + bits > 32)
+        {
+            v |= words[4 * (word + 1) + lane] << (32 - shift);
+        }
+        values[i] = v & mask;
+    }
+#endif
+    return data + 4 * bits * sizeof(uint32_t);
+}
+
+//把差值还原成文档id，base 为上一个块的最后一个文档id
+static void PrefixSum(uint32_t base, uint32_t* values)
+{
+#ifdef __SSE2__
+    __m128i* p = reinterpret_cast<__m128i*>(values);
+    __m128i prev = _mm_set1_epi32(base);
+    for(size_t k = 0; k < kPostingBlockSize / 4; ++k)
+    {
+        //块内4个数求前缀和，再加上前面所有数的和
+        __m128i v = _mm_loadu_si128(p + k);
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi32(v, prev);
+        _mm_storeu_si128(p + k, v);
+        prev = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+#else
+    for(size_t i = 0; i < kPostingBlockSize; ++i)
+    {
+        base += values[i];
+        values[i] = base;
+    }
+#endif
+}
+
+void PostingList::Encode(const InvertedList& inverted_list, std::string* data)
+{
+    //1. 先写拉链头和块头，块头中的偏移等写完块数据再回填
+    size_t list_beg = data->size();
+    PostingListHeader header;
+    memset(&header, 0, sizeof(header));
+    header.size = inverted_list.size();
+    header.block_cnt = (inverted_list.size() + kPostingBlockSize - 1) / kPostingBlockSize;
+    data->append(reinterpret_cast<const char*>(&header), sizeof(header));
+    size_t blocks_beg = data->size();
+    data->resize(blocks_beg + header.block_cnt * sizeof(PostingBlock));
+
+    //2. 依次写每个块的数据
+    uint32_t prev_doc_id = 0;
+    uint32_t deltas[kPostingBlockSize];
+    uint32_t title_tf[kPostingBlockSize];
+    uint32_t content_tf[kPostingBlockSize];
+    uint32_t positions[kPostingBlockSize];
+    for(uint32_t b = 0; b < header.block_cnt; ++b)
+    {
+        size_t beg = b * kPostingBlockSize;
+        size_t len = std::min(kPostingBlockSize, inverted_list.size() - beg);
+        PostingBlock block;
+        memset(&block, 0, sizeof(block));
+        block.offset = data->size() - list_beg;
+        block.last_doc_id = inverted_list.doc_ids[beg + len - 1];
+        uint32_t max_delta = 0;
+        uint32_t max_title_tf = 0;
+        uint32_t max_content_tf = 0;
+        uint32_t max_pos = 0;
+        for(size_t i = 0; i < len; ++i)
+        {
+            uint32_t doc_id = inverted_list.doc_ids[beg + i];
+            CHECK(doc_id >= prev_doc_id && (doc_id > prev_doc_id || beg + i == 0))
+                << "posting list not sorted by doc_id";
+            CHECK_GE(inverted_list.first_pos[beg + i], -1);
+            deltas[i] = doc_id - prev_doc_id;
+            title_tf[i] = inverted_list.title_tf[beg + i];
+            content_tf[i] = inverted_list.content_tf[beg + i];
+            //first_pos 可能为 -1，加一之后就是非负数了
+            positions[i] = inverted_list.first_pos[beg + i] + 1;
+            prev_doc_id = doc_id;
+            max_delta = std::max(max_delta, deltas[i]);
+            max_title_tf = std::max(max_title_tf, title_tf[i]);
+            max_content_tf = std::max(max_content_tf, content_tf[i]);
+            max_pos = std::max(max_pos, positions[i]);
+        }
+        block.max_title_tf = max_title_tf;
+        block.max_content_tf = max_content_tf;
+        header.max_title_tf = std::max(header.max_title_tf, block.max_title_tf);
+        header.max_content_tf = std::max(header.max_content_tf, block.max_content_tf);
+
+        if(len == kPostingBlockSize)
+        {
+            //满的块使用bit打包，位宽至少为1，用 doc_bits == 0 来标记 varint 编码的块
+            block.doc_bits = std::max<uint8_t>(BitWidth(max_delta), 1);
+            block.title_tf_bits = BitWidth(max_title_tf);
+            block.content_tf_bits = BitWidth(max_content_tf);
+            block.pos_bits = BitWidth(max_pos);
+            PackBlock(deltas, block.doc_bits, data);
+            PackBlock(title_tf, block.title_tf_bits, data);
+            PackBlock(content_tf, block.content_tf_bits, data);
+            PackBlock(positions, block.pos_bits, data);
+        }
+        else
+        {
+            //最后一个不满的块使用 varint 编码
+            for(size_t i = 0; i < len; ++i)
+            {
+                AppendVarint(deltas[i], data);
+                AppendVarint(title_tf[i], data);
+                AppendVarint(content_tf[i], data);
+                AppendVarint(positions[i], data);
+            }
+            //保持4字节对齐
+            data->resize((data->size() + 3) & ~(size_t)3);
+        }
+        memcpy(&(*data)[blocks_beg + b * sizeof(PostingBlock)], &block, sizeof(block));
+    }
+    //所有块都写完之后才知道整个拉链的最大词频
+    memcpy(&(*data)[list_beg], &header, sizeof(header));
+}
+
+//values 中小于 target 的个数，values 是有序的，所以也就是第一个 >= target 的位置
+//SSE2 一次比较4个数，没有分支
+static size_t CountLess(const uint32_t* values, size_t n, uint32_t target)
+{
+    size_t cnt = 0;
+    size_t i = 0;
+#ifdef __SSE2__
+    //SSE2 只有有符号数的比较，两边都加上 2^31 转成有符号数再比较，大小关系不变
+    const __m128i bias = _mm_set1_epi32(0x80000000);
+    const __m128i t = _mm_xor_si128(_mm_set1_epi32(target), bias);
+    for(; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)), bias);
+        cnt += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(v, t))));
+    }
+#endif
+    for(; i < n; ++i)
+    {
+        cnt += values[i] < target;
+    }
+    return cnt;
+}
+
+//先从 from 开始按照 1，2，4... 的步长往后跳(galloping)，找到目标所在的范围，再在范围内二分
+//求交集的时候每次往后跳的距离一般都不远，比直接在剩下的所有块中二分看的块头更少
+size_t PostingList::FindBlock(uint32_t doc_id, size_t from) const
+{
+    size_t beg = from;
+    size_t end = from;
+    size_t step = 1;
+    while(end < block_cnt() && block(end).last_doc_id < doc_id)
+    {
+        beg = end + 1;
+        end += step;
+        step <<= 1;
+    }
+    end = std::min<size_t>(end, block_cnt());
+    while(beg < end)
+    {
+        size_t mid = beg + (end - beg) / 2;
+        if(block(mid).last_doc_id < doc_id)
+        {
+            beg = mid + 1;
+        }
+        else
+        {
+            end = mid;
+        }
+    }
+    return beg;
+}
+
+size_t PostingList::DecodeBlock(size_t i, uint32_t* doc_ids, uint32_t* title_tf, uint32_t* content_tf,
+                                int32_t* first_pos) const
+{
+    const PostingBlock& cur = block(i);
+    uint32_t base = i == 0 ? 0 : block(i - 1).last_doc_id;
+    const char* data = data_ + cur.offset;
+    if(cur.doc_bits == 0)
+    {
+        size_t len = size() - i * kPostingBlockSize;
+        uint32_t value = 0;
+        for(size_t j = 0; j < len; ++j)
+        {
+            data = ReadVarint(data, &value);
+            base += value;
+            doc_ids[j] = base;
+            data = ReadVarint(data, &title_tf[j]);
+            data = ReadVarint(data, &content_tf[j]);
+            data = ReadVarint(data, &value);
+            first_pos[j] = (int32_t)value - 1;
+        }
+        return len;
+    }
+
+    data = UnpackBlock(data, cur.doc_bits, doc_ids);
+    PrefixSum(base, doc_ids);
+    data = UnpackBlock(data, cur.title_tf_bits, title_tf);
+    data = UnpackBlock(data, cur.content_tf_bits, content_tf);
+    UnpackBlock(data, cur.pos_bits, reinterpret_cast<uint32_t*>(first_pos));
+    for(size_t j = 0; j < kPostingBlockSize; ++j)
+    {
+        first_pos[j] -= 1;
+    }
+    return kPostingBlockSize;
+}
+
+void PostingList::Decode(InvertedList* inverted_list) const
+{
+    inverted_list->clear();
+    inverted_list->resize(size());
+    //内存中的词频是16位的，先解压到临时数组中再转换
+    uint32_t title_tf[kPostingBlockSize];
+    uint32_t content_tf[kPostingBlockSize];
+    for(size_t i = 0; i < block_cnt(); ++i)
+    {
+        size_t beg = i * kPostingBlockSize;
+        size_t len = DecodeBlock(i, &inverted_list->doc_ids[beg], title_tf, content_tf,
+                                 &inverted_list->first_pos[beg]);
+        std::copy(title_tf, title_tf + len, inverted_list->title_tf.begin() + beg);
+        std::copy(content_tf, content_tf + len, inverted_list->content_tf.begin() + beg);
+    }
+}
+
+void PositionList::Encode(const InvertedList& inverted_list, std::string* data)
+{
+    if(!inverted_list.has_positions())
+    {
+        return;
+    }
+    uint32_t block_cnt = (inverted_list.size() + kPostingBlockSize - 1) / kPostingBlockSize;
+    size_t header_off = data->size();
+    data->resize(header_off + (1 + block_cnt) * sizeof(uint32_t));
+    size_t data_off = data->size();
+    std::vector<uint32_t> header(1 + block_cnt);
+    header[0] = block_cnt;
+    for(size_t i = 0; i < inverted_list.size(); ++i)
+    {
+        if(i % kPostingBlockSize == 0)
+        {
+            header[1 + i / kPostingBlockSize] = data->size() - data_off;
+        }
+        uint32_t beg = inverted_list.position_beg(i);
+        uint32_t end = inverted_list.position_ends[i];
+        AppendVarint(end - beg, data);
+        uint32_t prev = 0;
+        for(uint32_t j = beg; j < end; ++j)
+        {
+            AppendVarint(inverted_list.positions[j] - prev, data);
+            prev = inverted_list.positions[j];
+        }
+    }
+    memcpy(&(*data)[header_off], header.data(), header.size() * sizeof(uint32_t));
+}
+
+void PositionList::Decode(InvertedList* inverted_list) const
+{
+    inverted_list->positions.clear();
+    inverted_list->position_ends.clear();
+    if(empty())
+    {
+        return;
+    }
+    uint32_t block_cnt = reinterpret_cast<const uint32_t*>(data_)[0];
+    //各个块的数据是连续存放的，直接顺序解压
+    const char* p = data_ + (1 + block_cnt) * sizeof(uint32_t);
+    for(size_t i = 0; i < inverted_list->size(); ++i)
+    {
+        uint32_t n = 0;
+        p = ReadVarint(p, &n);
+        uint32_t pos = 0;
+        for(uint32_t j = 0; j < n; ++j)
+        {
+            uint32_t delta = 0;
+            p = ReadVarint(p, &delta);
+            pos += delta;
+            inverted_list->positions.push_back(pos);
+        }
+        inverted_list->position_ends.push_back(inverted_list->positions.size());
+    }
+}
+
+void PositionList::Get(size_t i, std::vector<uint32_t>* positions) const
+{
+    positions->clear();
+    const uint32_t* header = reinterpret_cast<const uint32_t*>(data_);
+    const char* p = data_ + (1 + header[0]) * sizeof(uint32_t) + header[1 + i / kPostingBlockSize];
+    //跳过块内前面的文档，只需要数 varint 的结束字节，不需要解码
+    for(size_t j = i % kPostingBlockSize; j > 0; --j)
+    {
+        uint32_t n = 0;
+        p = ReadVarint(p, &n);
+        for(; n > 0; --n)
+        {
+            while(*p++ & 0x80)
+            {}
+        }
+    }
+    uint32_t n = 0;
+    p = ReadVarint(p, &n);
+    positions->resize(n);
+    uint32_t pos = 0;
+    for(uint32_t j = 0; j < n; ++j)
+    {
+        uint32_t delta = 0;
+        p = ReadVarint(p, &delta);
+        pos += delta;
+        (*positions)[j] = pos;
+    }
+}
+
+PostingIterator::PostingIterator(const PostingList& posting_list)
+    : posting_list_(posting_list)
+    , block_(0)
+    , pos_(0)
+    , block_len_(0)
+{
+    LoadBlock(0);
+}
+
+void PostingIterator::LoadBlock(size_t block)
+{
+    block_ = block;
+    pos_ = 0;
+    block_len_ = 0;
+    if(block < posting_list_.block_cnt())
+    {
+        block_len_ = posting_list_.DecodeBlock(block, doc_ids_, title_tf_, content_tf_, first_pos_);
+    }
+}
+
+void PostingIterator::SkipTo(uint32_t doc_id)
+{
+    if(!Valid() || doc_ids_[pos_] >= doc_id)
+    {
+        return;
+    }
+    if(doc_ids_[block_len_ - 1] < doc_id)
+    {
+        //目标不在当前块中，根据块头找到第一个 last_doc_id >= doc_id 的块
+        LoadBlock(posting_list_.FindBlock(doc_id, block_ + 1));
+        if(!Valid())
+        {
+            return;
+        }
+    }
+    //块内同样先倍增步长找到范围，范围内用 SIMD 数出比 doc_id 小的个数
+    size_t beg = pos_;
+    size_t end = pos_;
+    size_t step = 1;
+    while(end < block_len_ && doc_ids_[end] < doc_id)
+    {
+        beg = end + 1;
+        end += step;
+        step <<= 1;
+    }
+    end = std::min(end, block_len_);
+    pos_ = beg + CountLess(doc_ids_ + beg, end - beg, doc_id);
+}
+
+} //end doc_index
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+
+namespace doc_index
+{
+
+//倒排拉链中的一个元素，内容和 Weight 一样，但是只有 12 个字节
+//文档id使用32位整数，文档数不能超过 uint32_t 的范围
+//拉链中只保存词频，得分在查询的时候根据词频和文档长度计算(见 bm25.h)
+struct Posting
+{
+    uint32_t doc_id;
+    uint16_t title_tf;   //词在标题中出现的次数
+    uint16_t content_tf; //词在正文中出现的次数
+    int32_t first_pos;
+};
+
+//词频的上限，超出的按照上限保存
+static const uint32_t kMaxTf = 0xFFFF;
+
+//倒排拉链，倒排索引的每一组包含一个key和一个倒排拉链
+//内存中不保存 protobuf 的 Weight 对象(虚函数表，has_bits，64位id，对齐填充，
+//一个对象要比数据本身大好几倍)，而是把 doc_id，title_tf，content_tf，first_pos 分别保存在
+//几个紧凑的数组中，第 i 个元素对应拉链中的第 i 个文档，只有序列化的时候才转换成 Weight
+//拉链中的文档按照文档id升序排列
+//构建位置索引时，每个文档中词出现的位置(见 PositionList)依次拼接在 positions 中，
+//第 i 个文档的位置为 [position_ends[i - 1], position_ends[i])，
+//有文档没有位置时(比如不构建位置索引)，整个拉链都当作没有位置
+struct InvertedList
+{
+    std::vector<uint32_t> doc_ids;
+    std::vector<uint16_t> title_tf;
+    std::vector<uint16_t> content_tf;
+    std::vector<int32_t> first_pos;
+    std::vector<uint32_t> positions;
+    std::vector<uint32_t> position_ends;
+
+    size_t size() const
+    {
+        return doc_ids.size();
+    }
+
+    bool has_positions() const
+    {
+        return !doc_ids.empty() && position_ends.size() == doc_ids.size();
+    }
+
+    //第 i 个文档的位置的起始下标
+    uint32_t position_beg(size_t i) const
+    {
+        return i == 0 ? 0 : position_ends[i - 1];
+    }
+
+    bool empty() const
+    {
+        return doc_ids.empty();
+    }
+
+    Posting at(size_t i) const
+    {
+        Posting posting = {doc_ids[i], title_tf[i], content_tf[i], first_pos[i]};
+        return posting;
+    }
+
+    void push_back(const Posting& posting)
+    {
+        doc_ids.push_back(posting.doc_id);
+        title_tf.push_back(posting.title_tf);
+        content_tf.push_back(posting.content_tf);
+        first_pos.push_back(posting.first_pos);
+    }
+
+    //带位置的文档，positions 为词在这个文档中出现的位置，升序排列
+    void push_back(const Posting& posting, const uint32_t* doc_positions, size_t n)
+    {
+        push_back(posting);
+        positions.insert(positions.end(), doc_positions, doc_positions + n);
+        position_ends.push_back(positions.size());
+    }
+
+    //两边都有位置时位置也接上，否则结果没有位置
+    void append(const InvertedList& other)
+    {
+        bool keep_positions = position_ends.size() == size() && other.position_ends.size() == other.size();
+        uint32_t base = positions.size();
+        doc_ids.insert(doc_ids.end(), other.doc_ids.begin(), other.doc_ids.end());
+        title_tf.insert(title_tf.end(), other.title_tf.begin(), other.title_tf.end());
+        content_tf.insert(content_tf.end(), other.content_tf.begin(), other.content_tf.end());
+        first_pos.insert(first_pos.end(), other.first_pos.begin(), other.first_pos.end());
+        if(!keep_positions)
+        {
+            positions.clear();
+            position_ends.clear();
+            return;
+        }
+        positions.insert(positions.end(), other.positions.begin(), other.positions.end());
+        for(uint32_t end : other.position_ends)
+        {
+            position_ends.push_back(base + end);
+        }
+    }
+
+    void reserve(size_t n)
+    {
+        doc_ids.reserve(n);
+        title_tf.reserve(n);
+        content_tf.reserve(n);
+        first_pos.reserve(n);
+    }
+
+    void resize(size_t n)
+    {
+        doc_ids.resize(n);
+        title_tf.resize(n);
+        content_tf.resize(n);
+        first_pos.resize(n);
+    }
+
+    void clear()
+    {
+        doc_ids.clear();
+        title_tf.clear();
+        content_tf.clear();
+        first_pos.clear();
+        positions.clear();
+        position_ends.clear();
+    }
+
+    void swap(InvertedList& other)
+    {
+        doc_ids.swap(other.doc_ids);
+        title_tf.swap(other.title_tf);
+        content_tf.swap(other.content_tf);
+        first_pos.swap(other.first_pos);
+        positions.swap(other.positions);
+        position_ends.swap(other.position_ends);
+    }
+};
+
+//varint 编码，每个字节保存7位，最高位为1表示后面还有字节
+inline void AppendVarint(uint32_t value, std::string* data)
+{
+    while(value >= 0x80)
+    {
+        data->push_back((char)(value | 0x80));
+        value >>= 7;
+    }
+    data->push_back((char)value);
+}
+
+//返回读取之后的位置
+inline const char* ReadVarint(const char* data, uint32_t* value)
+{
+    uint32_t result = 0;
+    for(int shift = 0; ; shift += 7)
+    {
+        uint8_t byte = *data++;
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if((byte & 0x80) == 0)
+        {
+            break;
+        }
+    }
+    *value = result;
+    return data;
+}
+
+//压缩拉链中每个块包含的文档数
+static const size_t kPostingBlockSize = 128;
+
+//压缩拉链的头部
+//size 就是包含这个词的文档数(df)，打分的时候用来计算 idf
+struct PostingListHeader
+{
+    uint32_t size;           //拉链中的文档数
+    uint32_t block_cnt;      //块数
+    uint16_t max_title_tf;   //整个拉链中最大的标题词频，
+    uint16_t max_content_tf; //和最大的正文词频，WAND 用来估算文档得分的上限
+    uint32_t reserved;
+};
+
+//压缩拉链中每个块的块头，所有块头连续存放在拉链头部之后，
+//跳转(SkipTo)的时候只需要看块头，不需要解压块的数据
+struct PostingBlock
+{
+    uint32_t last_doc_id;    //块中最后一个(也就是最大的)文档id
+    uint32_t offset;         //块数据相对于拉链数据起始位置的偏移
+    uint16_t max_title_tf;   //块中最大的标题词频
+    uint16_t max_content_tf; //块中最大的正文词频
+    uint8_t doc_bits;        //文档id差值的bit位宽，为0表示这个块使用 varint 编码
+    uint8_t title_tf_bits;   //标题词频的bit位宽
+    uint8_t content_tf_bits; //正文词频的bit位宽
+    uint8_t pos_bits;        //first_pos + 1 的bit位宽
+};
+
+//压缩之后的倒排拉链(只读)
+//拉链中的文档按照id升序排列，每 kPostingBlockSize 个文档为一个块：
+//  文档id保存和前一个文档id的差值(第一个文档和上一个块的 last_doc_id 的差值)，
+//  差值、标题词频、正文词频、first_pos + 1 这四组数分别按照块内的最大值确定bit位宽进行bit打包。
+//  打包的格式是4路交错的，第 i 个数放在第 i % 4 路，每一路是一个连续的bit流，
+//  4路的32位字交替存放，这样解压时可以用 SSE 指令一次解出相邻的4个数；
+//  最后一个不足 kPostingBlockSize 个文档的块使用 varint 编码
+//数据的格式为：PostingListHeader + block_cnt 个 PostingBlock + 各个块的数据，
+//所有部分都是4字节对齐的
+//PostingList 本身不持有数据，只是数据的一个视图，数据的生命周期由调用者保证
+class PostingList
+{
+public:
+    PostingList()
+        : data_(NULL)
+        , len_(0)
+    {}
+
+    PostingList(const char* data, size_t len)
+        : data_(data)
+        , len_(len)
+    {}
+
+    //把按照文档id升序排列的拉链压缩，结果追加到 data 中
+    static void Encode(const InvertedList& inverted_list, std::string* data);
+
+    //解压整个拉链
+    void Decode(InvertedList* inverted_list) const;
+
+    uint32_t size() const
+    {
+        return data_ == NULL ? 0 : header()->size;
+    }
+
+    uint32_t block_cnt() const
+    {
+        return data_ == NULL ? 0 : header()->block_cnt;
+    }
+
+    uint16_t max_title_tf() const
+    {
+        return data_ == NULL ? 0 : header()->max_title_tf;
+    }
+
+    uint16_t max_content_tf() const
+    {
+        return data_ == NULL ? 0 : header()->max_content_tf;
+    }
+
+    const PostingBlock& block(size_t i) const
+    {
+        return reinterpret_cast<const PostingBlock*>(data_ + sizeof(PostingListHeader))[i];
+    }
+
+    //从第 from 块开始，根据块头倍增步长找到第一个 last_doc_id >= doc_id 的块，
+    //不存在时返回 block_cnt()
+    size_t FindBlock(uint32_t doc_id, size_t from) const;
+
+    //解压第 i 个块，返回块中的文档数
+    //每个数组都要能放下 kPostingBlockSize 个元素
+    size_t DecodeBlock(size_t i, uint32_t* doc_ids, uint32_t* title_tf, uint32_t* content_tf,
+                       int32_t* first_pos) const;
+
+    //压缩之后的原始数据
+    const char* data() const
+    {
+        return data_;
+    }
+
+    size_t len() const
+    {
+        return len_;
+    }
+
+private:
+    const PostingListHeader* header() const
+    {
+        return reinterpret_cast<const PostingListHeader*>(data_);
+    }
+
+    const char* data_;
+    size_t len_;
+};
+
+//位置索引中，正文的位置从 标题的词数 + kFieldGap 开始，
+//短语匹配允许的间隔比它小，标题末尾和正文开头的词不会被当成相邻的
+static const uint32_t kFieldGap = 1024;
+
+//一个关键词的位置索引，和 PostingList 中的文档一一对应(只读)
+//位置是词在标题或者正文的分词结果中的下标(暂停词也占一个位置)，
+//标题中的词从0开始，正文中的词从 标题的词数 + kFieldGap 开始
+//数据的格式为：uint32_t 块数 + 每块一个 uint32_t 的偏移(相对于块数据的起始位置) + 各个块的数据，
+//块和 PostingList 中的块一一对应，每个文档依次保存 varint(位置个数) + 每个位置和前一个位置的差值的 varint，
+//查询时先根据偏移找到文档所在的块，再跳过块内前面的文档
+//PositionList 本身不持有数据，只是数据的一个视图
+class PositionList
+{
+public:
+    PositionList()
+        : data_(NULL)
+        , len_(0)
+    {}
+
+    PositionList(const char* data, size_t len)
+        : data_(data)
+        , len_(len)
+    {}
+
+    //把拉链中的位置压缩，结果追加到 data 中，拉链没有位置时不追加任何数据
+    static void Encode(const InvertedList& inverted_list, std::string* data);
+
+    //inverted_list 中已经解压好了文档，补上每个文档的位置
+    void Decode(InvertedList* inverted_list) const;
+
+    //没有位置索引
+    bool empty() const
+    {
+        return len_ == 0;
+    }
+
+    //拉链中第 i 个文档的位置
+    void Get(size_t i, std::vector<uint32_t>* positions) const;
+
+    const char* data() const
+    {
+        return data_;
+    }
+
+    size_t len() const
+    {
+        return len_;
+    }
+
+private:
+    const char* data_;
+    size_t len_;
+};
+
+//按照文档id升序遍历压缩拉链，每次解压一个块
+class PostingIterator
+{
+public:
+    explicit PostingIterator(const PostingList& posting_list);
+
+    //重新指向另一个拉链，从第一个文档开始
+    void Reset(const PostingList& posting_list)
+    {
+        posting_list_ = posting_list;
+        LoadBlock(0);
+    }
+
+    bool Valid() const
+    {
+        return pos_ < block_len_;
+    }
+
+    void Next()
+    {
+        if(++pos_ == block_len_)
+        {
+            LoadBlock(block_ + 1);
+        }
+    }
+
+    //跳到第一个文档id >= doc_id 的位置，只能往后跳
+    //先根据块头中的 last_doc_id 跳过整个的块，再在块内倍增步长查找
+    void SkipTo(uint32_t doc_id);
+
+    //当前解压的块
+    size_t current_block() const
+    {
+        return block_;
+    }
+
+    uint32_t doc_id() const
+    {
+        return doc_ids_[pos_];
+    }
+
+    //当前文档是拉链中的第几个文档
+    size_t ordinal() const
+    {
+        return block_ * kPostingBlockSize + pos_;
+    }
+
+    uint32_t title_tf() const
+    {
+        return title_tf_[pos_];
+    }
+
+    uint32_t content_tf() const
+    {
+        return content_tf_[pos_];
+    }
+
+    int32_t first_pos() const
+    {
+        return first_pos_[pos_];
+    }
+
+    Posting posting() const
+    {
+        Posting posting = {doc_ids_[pos_], (uint16_t)title_tf_[pos_], (uint16_t)content_tf_[pos_], first_pos_[pos_]};
+        return posting;
+    }
+
+private:
+    void LoadBlock(size_t block);
+
+    PostingList posting_list_;
+    size_t block_;     //当前解压的块
+    size_t pos_;       //当前元素在块中的下标
+    size_t block_len_; //当前块中的元素个数
+    uint32_t doc_ids_[kPostingBlockSize];
+    uint32_t title_tf_[kPostingBlockSize];
+    uint32_t content_tf_[kPostingBlockSize];
+    int32_t first_pos_[kPostingBlockSize];
+};
+
+} //end doc_index
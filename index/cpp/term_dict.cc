@@ -0,0 +1,33 @@
+#include "term_dict.h"
+#include <algorithm>
+
+
+namespace doc_index
+{
+
+void TermDict::SortedIds(std::vector<uint32_t>* term_ids) const
+{
+    term_ids->resize(terms_.size());
+    for(uint32_t i = 0; i < terms_.size(); ++i)
+    {
+        (*term_ids)[i] = i;
+    }
+    std::sort(term_ids->begin(), term_ids->end(),
+              [this](uint32_t t1, uint32_t t2)
+              {
+                  return terms_[t1] < terms_[t2];
+              });
+}
+
+//每个关键词算一个 std::string 和一个哈希节点的开销，加上关键词本身
+size_t TermDict::MemoryUsage() const
+{
+    size_t size = 0;
+    for(const auto& term : terms_)
+    {
+        size += sizeof(std::string) + 48 + term.capacity();
+    }
+    return size;
+}
+
+} //end doc_index
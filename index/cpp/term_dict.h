@@ -0,0 +1,112 @@
+#pragma once
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+#include "posting_list.h"
+#include "../../common/util.hpp"
+
+
+namespace doc_index
+{
+
+static const uint32_t kInvalidTermId = static_cast<uint32_t>(-1);
+
+//构建索引时使用的关键词词典，把关键词映射成从0开始连续分配的整数id
+//每个关键词只保存一份，查找的时候使用 StringPiece，不需要构造 std::string
+class TermDict
+{
+public:
+    //查找关键词的id，不存在时返回 kInvalidTermId
+    uint32_t Find(const common::StringPiece& term) const
+    {
+        auto it = ids_.find(term);
+        return it == ids_.end() ? kInvalidTermId : it->second;
+    }
+
+    //查找关键词的id，不存在时插入一个新的id
+    uint32_t Insert(const common::StringPiece& term)
+    {
+        auto it = ids_.find(term);
+        if(it != ids_.end())
+        {
+            return it->second;
+        }
+        uint32_t term_id = terms_.size();
+        //deque 插入元素时已有的元素不会移动，ids_ 中的 key 可以直接指向它们
+        terms_.push_back(term.ToString());
+        ids_.insert(std::make_pair(common::StringPiece(terms_.back()), term_id));
+        return term_id;
+    }
+
+    const std::string& term(uint32_t term_id) const
+    {
+        return terms_[term_id];
+    }
+
+    size_t size() const
+    {
+        return terms_.size();
+    }
+
+    //所有关键词的id，按照关键词的字典序排列
+    void SortedIds(std::vector<uint32_t>* term_ids) const;
+
+    //估算占用的内存大小
+    size_t MemoryUsage() const;
+
+    void swap(TermDict& other)
+    {
+        terms_.swap(other.terms_);
+        ids_.swap(other.ids_);
+    }
+
+private:
+    std::deque<std::string> terms_;
+    std::unordered_map<common::StringPiece, uint32_t, common::StringPieceHash> ids_;
+};
+
+//构建中的倒排索引，关键词通过 TermDict 映射成id，拉链按照id存放在数组中
+struct InvertedIndex
+{
+    TermDict dict;
+    std::vector<InvertedList> lists; //lists[i] 为id为 i 的关键词的拉链
+
+    //获取关键词的拉链，不存在时插入一个空的拉链
+    InvertedList& operator[](const common::StringPiece& term)
+    {
+        uint32_t term_id = dict.Insert(term);
+        if(term_id == lists.size())
+        {
+            lists.push_back(InvertedList());
+        }
+        return lists[term_id];
+    }
+
+    //关键词不存在时返回 NULL
+    const InvertedList* Find(const common::StringPiece& term) const
+    {
+        uint32_t term_id = dict.Find(term);
+        return term_id == kInvalidTermId ? NULL : &lists[term_id];
+    }
+
+    size_t size() const
+    {
+        return lists.size();
+    }
+
+    bool empty() const
+    {
+        return lists.empty();
+    }
+
+    void swap(InvertedIndex& other)
+    {
+        dict.swap(other.dict);
+        lists.swap(other.lists);
+    }
+};
+
+} //end doc_index
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+
+namespace doc_server
+{
+
+//按文档累加得分(term-at-a-time)的稠密累加器，下标就是文档id
+//数组按照文档数分配，每个线程一个，在请求之间复用，不需要每次都分配和清零，
+//只记录本次请求碰到过的文档(touched)，下次使用前只把这些位置还原
+class ScoreAccumulator
+{
+public:
+    //开始一次新的累加，doc_cnt 为文档id的上限
+    void Reset(size_t doc_cnt)
+    {
+        for(uint32_t doc_id : touched_)
+        {
+            entries_[doc_id].best_weight = -1;
+        }
+        touched_.clear();
+        if(entries_.size() < doc_cnt)
+        {
+            entries_.resize(doc_cnt);
+        }
+    }
+
+    //累加一个查询词在文档中的权重，first_pos 取权重最大的查询词的
+    void Add(uint32_t doc_id, int32_t weight, int32_t first_pos)
+    {
+        Entry& entry = entries_[doc_id];
+        if(entry.best_weight < 0)
+        {
+            touched_.push_back(doc_id);
+            entry.score = weight;
+            entry.best_weight = weight;
+            entry.first_pos = first_pos;
+            return;
+        }
+        entry.score += weight;
+        if(weight > entry.best_weight)
+        {
+            entry.best_weight = weight;
+            entry.first_pos = first_pos;
+        }
+    }
+
+    //本次累加碰到过的文档，按照第一次碰到的顺序
+    const std::vector<uint32_t>& touched() const
+    {
+        return touched_;
+    }
+
+    int64_t score(uint32_t doc_id) const
+    {
+        return entries_[doc_id].score;
+    }
+
+    int32_t first_pos(uint32_t doc_id) const
+    {
+        return entries_[doc_id].first_pos;
+    }
+
+private:
+    struct Entry
+    {
+        int64_t score;
+        int32_t best_weight; //小于0表示本次请求还没有碰到这个文档
+        int32_t first_pos;
+
+        Entry()
+            : score(0)
+            , best_weight(-1)
+            , first_pos(-1)
+        {}
+    };
+
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> touched_;
+};
+
+} //end doc_server
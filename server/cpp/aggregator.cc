@@ -0,0 +1,325 @@
+#include "aggregator.h"
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <glog/logging.h>
+#include <sofa/pbrpc/pbrpc.h>
+#include "../../common/util.hpp"
+
+
+namespace doc_server
+{
+
+typedef doc_server_proto::DocServerAPI DocServerAPI;
+typedef doc_server_proto::Request Request;
+typedef doc_server_proto::Response Response;
+typedef doc_server_proto::FetchDocsRequest FetchDocsRequest;
+
+//取最终页面上的文档内容时最少等待的时间(毫秒)
+static const int64_t kMinFetchTimeoutMs = 50;
+
+//等待一组异步 RPC 全部完成，每个 RPC 完成时调用一次 Done
+class RpcLatch
+{
+public:
+    explicit RpcLatch(size_t cnt)
+        : cnt_(cnt)
+    {}
+
+    void Done()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(--cnt_ == 0)
+        {
+            cond_.notify_all();
+        }
+    }
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this]{ return cnt_ == 0; });
+    }
+
+private:
+    size_t cnt_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+};
+
+//同时调用 ids 中的各个分片的 method，请求为 reqs[id]，响应写到 resps[id]，全部完成之后返回
+//ok[id] 为这个分片的 RPC 是否成功
+template <typename Req, typename Resp>
+static void CallShards(const std::vector<DocServerAPI*>& shards, int64_t timeout_ms,
+                       void (DocServerAPI::*method)(google::protobuf::RpcController*, const Req*,
+                                                    Resp*, google::protobuf::Closure*),
+                       const std::vector<uint32_t>& ids, const std::vector<Req>& reqs,
+                       std::vector<Resp>* resps, std::vector<bool>* ok)
+{
+    std::vector<sofa::pbrpc::RpcController> ctrls(shards.size());
+    RpcLatch latch(ids.size());
+    for(uint32_t id : ids)
+    {
+        ctrls[id].SetTimeout(timeout_ms);
+        (shards[id]->*method)(&ctrls[id], &reqs[id], &(*resps)[id],
+                              google::protobuf::NewCallback(&latch, &RpcLatch::Done));
+    }
+    latch.Wait();
+    ok->assign(shards.size(), false);
+    for(uint32_t id : ids)
+    {
+        if(ctrls[id].Failed())
+        {
+            LOG(WARNING) << "shard rpc failed! shard=" << id << " error=" << ctrls[id].ErrorText();
+            continue;
+        }
+        (*ok)[id] = true;
+    }
+}
+
+Aggregator::Aggregator(const std::vector<DocServerAPI*>& shards, int64_t timeout_ms,
+                       int64_t update_timeout_ms, int64_t reload_timeout_ms,
+                       size_t max_page_size, size_t max_result_window)
+    : shards_(shards)
+    , timeout_ms_(timeout_ms)
+    , update_timeout_ms_(update_timeout_ms)
+    , reload_timeout_ms_(reload_timeout_ms)
+    , max_page_size_(max_page_size)
+    , max_result_window_(max_result_window)
+{
+    CHECK(!shards_.empty());
+}
+
+//得分高的在前面，得分相同时按照分片和文档id，保证同样的结果排序一样
+bool Aggregator::CmpScore(const ShardDoc& d1, const ShardDoc& d2)
+{
+    if(d1.score != d2.score)
+    {
+        return d1.score > d2.score;
+    }
+    return d1.shard != d2.shard ? d1.shard < d2.shard : d1.doc_id < d2.doc_id;
+}
+
+//请求分片的超时时间不超过请求剩下的时间，至少 1 毫秒(超时时间为 0 表示不限制)
+int64_t Aggregator::ShardTimeout(int64_t deadline_ms) const
+{
+    if(deadline_ms <= 0)
+    {
+        return timeout_ms_;
+    }
+    return std::max<int64_t>(std::min(timeout_ms_, deadline_ms - common::TimeUtil::TimeStampMS()), 1);
+}
+
+void Aggregator::Search(const Request& req, Response* resp, int64_t received_ms)
+{
+    resp->set_sid(req.sid());
+    resp->set_timestamp(common::TimeUtil::TimeStamp());
+    //请求中的超时时间换算成本地的截止时间，和分片服务器一样，开始处理时已经过了截止时间的请求直接丢弃
+    int64_t deadline_ms = 0;
+    if(req.timeout_ms() > 0)
+    {
+        deadline_ms = (received_ms > 0 ? received_ms : common::TimeUtil::TimeStampMS()) + req.timeout_ms();
+    }
+    if(deadline_ms > 0 && common::TimeUtil::TimeStampMS() >= deadline_ms)
+    {
+        LOG(WARNING) << "Aggregator Search request expired! sid=" << req.sid();
+        resp->set_err_code(-3);
+        return;
+    }
+    //分页参数的限制和单机服务器一样
+    size_t num = std::min<size_t>(req.num(), max_page_size_);
+    size_t limit = std::min<size_t>((size_t)req.offset() + num, max_result_window_);
+    size_t offset = std::min<size_t>(req.offset(), limit);
+
+    //1. 同时向所有的分片查询前 limit 个文档的id和得分，这一页一定在它们合并之后的前 limit 个中
+    std::vector<uint32_t> all_ids;
+    for(uint32_t i = 0; i < shards_.size(); ++i)
+    {
+        all_ids.push_back(i);
+    }
+    Request shard_req(req);
+    shard_req.set_offset(0);
+    shard_req.set_num(limit);
+    shard_req.set_doc_only(true);
+    //剩下的时间作为超时时间传给分片，分片在时间用完之后提前结束
+    int64_t shard_timeout_ms = ShardTimeout(deadline_ms);
+    //发送时间换成聚合服务器现在的时间，分片从这时开始计算剩下的时间
+    shard_req.set_sent_ms(common::TimeUtil::TimeStampMS());
+    if(deadline_ms > 0)
+    {
+        shard_req.set_timeout_ms(shard_timeout_ms);
+    }
+    std::vector<Request> shard_reqs(shards_.size(), shard_req);
+    std::vector<Response> shard_resps(shards_.size());
+    std::vector<bool> ok;
+    CallShards(shards_, shard_timeout_ms, &DocServerAPI::Search, all_ids, shard_reqs, &shard_resps, &ok);
+
+    //2. 合并各个分片的结果，有分片失败、超时或者提前结束时结果不完整
+    std::vector<ShardDoc> docs;
+    uint64_t total_hits = 0;
+    size_t ok_cnt = 0;
+    bool partial = false;
+    for(uint32_t i = 0; i < shards_.size(); ++i)
+    {
+        if(!ok[i] || shard_resps[i].err_code() != 0)
+        {
+            partial = true;
+            continue;
+        }
+        ++ok_cnt;
+        partial = partial || shard_resps[i].partial();
+        total_hits += shard_resps[i].total_hits();
+        for(const auto& item : shard_resps[i].item())
+        {
+            ShardDoc doc = {item.score(), i, item.doc_id(), item.first_pos()};
+            docs.push_back(doc);
+        }
+    }
+    if(ok_cnt == 0)
+    {
+        LOG(ERROR) << "Aggregator Search all shards failed! sid=" << req.sid();
+        resp->set_err_code(-1);
+        return;
+    }
+    if(docs.size() > limit)
+    {
+        std::partial_sort(docs.begin(), docs.begin() + limit, docs.end(), CmpScore);
+        docs.resize(limit);
+    }
+    else
+    {
+        std::sort(docs.begin(), docs.end(), CmpScore);
+    }
+
+    //3. 只对 [offset, limit) 这一页上的文档，向所在的分片取标题和描述
+    std::vector<FetchDocsRequest> fetch_reqs(shards_.size());
+    std::vector<Response> fetch_resps(shards_.size());
+    //page_pos[i][k] 为第 i 个分片的第 k 个文档在这一页中的位置
+    std::vector<std::vector<size_t>> page_pos(shards_.size());
+    std::vector<uint32_t> fetch_ids;
+    for(size_t i = offset; i < docs.size(); ++i)
+    {
+        uint32_t shard = docs[i].shard;
+        FetchDocsRequest& fetch_req = fetch_reqs[shard];
+        if(page_pos[shard].empty())
+        {
+            fetch_req.set_sid(req.sid());
+            fetch_req.set_timestamp(req.timestamp());
+            fetch_req.set_query(req.query());
+            fetch_req.set_index_generation(shard_resps[shard].index_generation());
+            fetch_ids.push_back(shard);
+        }
+        auto* doc_ref = fetch_req.add_doc();
+        doc_ref->set_doc_id(docs[i].doc_id);
+        doc_ref->set_first_pos(docs[i].first_pos);
+        page_pos[shard].push_back(i - offset);
+    }
+    //取内容的文档数很少，截止时间已经到了也还是要取，否则这一页就是空的
+    CallShards(shards_, std::max<int64_t>(ShardTimeout(deadline_ms), kMinFetchTimeoutMs),
+               &DocServerAPI::FetchDocs, fetch_ids, fetch_reqs, &fetch_resps, &ok);
+
+    //4. 按照合并之后的顺序拼装响应，取不到内容的文档(分片失败或者重新加载了索引)跳过，
+    //   这一页少了文档，结果也是不完整的
+    std::vector<const doc_server_proto::Item*> page(docs.size() > offset ? docs.size() - offset : 0, NULL);
+    for(uint32_t shard : fetch_ids)
+    {
+        const Response& fetch_resp = fetch_resps[shard];
+        if(!ok[shard] || fetch_resp.err_code() != 0)
+        {
+            LOG(WARNING) << "Aggregator FetchDocs failed! sid=" << req.sid() << " shard=" << shard
+                         << " err_code=" << fetch_resp.err_code();
+            continue;
+        }
+        for(int k = 0; k < fetch_resp.item_size() && k < (int)page_pos[shard].size(); ++k)
+        {
+            if(!fetch_resp.item(k).jump_url().empty())
+            {
+                page[page_pos[shard][k]] = &fetch_resp.item(k);
+            }
+        }
+    }
+    for(const auto* item : page)
+    {
+        if(item == NULL)
+        {
+            partial = true;
+            continue;
+        }
+        resp->add_item()->CopyFrom(*item);
+    }
+    resp->set_err_code(0);
+    resp->set_total_hits(total_hits);
+    resp->set_partial(partial);
+}
+
+void Aggregator::AddDocument(const doc_server_proto::AddDocumentRequest& req,
+                             doc_server_proto::AddDocumentResponse* resp)
+{
+    uint32_t shard = common::StringUtil::ShardOf(req.jump_url(), shards_.size());
+    std::vector<uint32_t> ids(1, shard);
+    std::vector<doc_server_proto::AddDocumentRequest> reqs(shards_.size());
+    reqs[shard] = req;
+    std::vector<doc_server_proto::AddDocumentResponse> resps(shards_.size());
+    std::vector<bool> ok;
+    CallShards(shards_, update_timeout_ms_, &DocServerAPI::AddDocument, ids, reqs, &resps, &ok);
+    resp->CopyFrom(resps[shard]);
+    resp->set_sid(req.sid());
+    if(!ok[shard])
+    {
+        resp->set_err_code(-1);
+    }
+}
+
+void Aggregator::DeleteDocument(const doc_server_proto::DeleteDocumentRequest& req,
+                                doc_server_proto::DeleteDocumentResponse* resp)
+{
+    uint32_t shard = common::StringUtil::ShardOf(req.jump_url(), shards_.size());
+    std::vector<uint32_t> ids(1, shard);
+    std::vector<doc_server_proto::DeleteDocumentRequest> reqs(shards_.size());
+    reqs[shard] = req;
+    std::vector<doc_server_proto::DeleteDocumentResponse> resps(shards_.size());
+    std::vector<bool> ok;
+    CallShards(shards_, update_timeout_ms_, &DocServerAPI::DeleteDocument, ids, reqs, &resps, &ok);
+    resp->CopyFrom(resps[shard]);
+    resp->set_sid(req.sid());
+    if(!ok[shard])
+    {
+        resp->set_err_code(-1);
+    }
+}
+
+void Aggregator::ReloadIndex(const doc_server_proto::ReloadIndexRequest& req,
+                             doc_server_proto::ReloadIndexResponse* resp)
+{
+    std::vector<uint32_t> ids;
+    std::vector<doc_server_proto::ReloadIndexRequest> reqs(shards_.size());
+    for(uint32_t i = 0; i < shards_.size(); ++i)
+    {
+        ids.push_back(i);
+        reqs[i].set_sid(req.sid());
+        if(!req.index_path().empty())
+        {
+            reqs[i].set_index_path(req.index_path() + "." + std::to_string(i));
+        }
+    }
+    std::vector<doc_server_proto::ReloadIndexResponse> resps(shards_.size());
+    std::vector<bool> ok;
+    //分片在加载完成之后才返回，超时之后分片可能还是会换成新的索引，这里只是不再等待
+    CallShards(shards_, reload_timeout_ms_, &DocServerAPI::ReloadIndex, ids, reqs, &resps, &ok);
+    resp->set_sid(req.sid());
+    resp->set_err_code(0);
+    uint64_t doc_cnt = 0;
+    for(uint32_t i = 0; i < shards_.size(); ++i)
+    {
+        if(!ok[i] || resps[i].err_code() != 0)
+        {
+            LOG(ERROR) << "Aggregator ReloadIndex failed! shard=" << i;
+            resp->set_err_code(-1);
+            continue;
+        }
+        doc_cnt += resps[i].doc_cnt();
+    }
+    resp->set_doc_cnt(doc_cnt);
+}
+
+} //end doc_server
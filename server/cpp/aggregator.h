@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <stdint.h>
+#include "server.pb.h"
+
+
+namespace doc_server
+{
+
+//分片部署时的聚合服务器，对外提供和单机服务器一样的接口
+//文档按照 jump_url 切分到多个分片中(见 index_builder 的 --shard_num)，每个分片由一个服务器加载：
+//查询同时发给所有的分片(doc_only，只取文档id和得分)，合并各个分片的前 offset + num 个结果，
+//最后只对这一页上的文档向所在的分片取标题和描述
+//得分使用各个分片自己的统计信息(文档数、平均长度、df)计算，
+//文档是按照 url 的哈希随机切分的，分片足够大时和全局的统计信息相差很小
+class Aggregator
+{
+public:
+    //shards[i] 为第 i 个分片的服务(RPC 的 stub)，顺序和构建时的分片编号一致，不拥有所有权
+    //timeout_ms 为查询分片的超时时间，update_timeout_ms 为新增和删除文档的超时时间，
+    //reload_timeout_ms 为重新加载索引的超时时间，分片加载完整个索引之后才返回，要比查询长得多
+    //max_page_size 和 max_result_window 的含义和分片服务器上的同名参数一样
+    Aggregator(const std::vector<doc_server_proto::DocServerAPI*>& shards, int64_t timeout_ms,
+               int64_t update_timeout_ms, int64_t reload_timeout_ms,
+               size_t max_page_size, size_t max_result_window);
+
+    //搜索，部分分片失败时只合并成功的分片的结果，全部失败时 err_code 为 -1
+    //received_ms 为收到请求的时间(毫秒时间戳)，请求的 timeout_ms 从这时开始计算，0 表示现在
+    void Search(const doc_server_proto::Request& req, doc_server_proto::Response* resp, int64_t received_ms = 0);
+
+    //新增和删除文档转发给文档所在的分片，返回的 doc_id 是分片内的文档id
+    void AddDocument(const doc_server_proto::AddDocumentRequest& req,
+                     doc_server_proto::AddDocumentResponse* resp);
+    void DeleteDocument(const doc_server_proto::DeleteDocumentRequest& req,
+                        doc_server_proto::DeleteDocumentResponse* resp);
+
+    //所有的分片都重新加载索引，index_path 不为空时第 i 个分片加载 index_path.i
+    //有分片失败时 err_code 为 -1，doc_cnt 为成功的分片的文档数之和
+    void ReloadIndex(const doc_server_proto::ReloadIndexRequest& req,
+                     doc_server_proto::ReloadIndexResponse* resp);
+
+private:
+    //合并时一个分片返回的一个文档
+    struct ShardDoc
+    {
+        int64_t score;
+        uint32_t shard;
+        uint32_t doc_id;
+        int32_t first_pos;
+    };
+
+    static bool CmpScore(const ShardDoc& d1, const ShardDoc& d2);
+
+    //请求分片时使用的超时时间，deadline_ms 为请求在本地的截止时间
+    int64_t ShardTimeout(int64_t deadline_ms) const;
+
+    std::vector<doc_server_proto::DocServerAPI*> shards_;
+    int64_t timeout_ms_;
+    int64_t update_timeout_ms_;
+    int64_t reload_timeout_ms_;
+    size_t max_page_size_;
+    size_t max_result_window_;
+};
+
+} //end doc_server
@@ -0,0 +1,136 @@
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <glog/logging.h>
+#include <gflags/gflags.h>
+#include <base/base.h>
+#include <sofa/pbrpc/pbrpc.h>
+#include "../../common/util.hpp"
+#include "server.pb.h"
+#include "aggregator.h"
+
+
+DEFINE_string(port, "10100", "聚合服务器端口号");
+DEFINE_string(shard_addrs, "127.0.0.1:10000", "各个分片服务器的地址，用逗号分开，顺序和构建索引时的分片编号一致");
+DEFINE_int32(shard_timeout_ms, 1000, "请求分片服务器的超时时间(毫秒)，超时的分片不参与合并");
+DEFINE_int32(shard_update_timeout_ms, 5000, "向分片服务器新增、删除文档的超时时间(毫秒)");
+DEFINE_int32(shard_reload_timeout_ms, 600000, "分片服务器重新加载索引的超时时间(毫秒)，分片加载完整个索引之后才返回");
+DEFINE_int32(max_clock_skew_ms, 50, "发送方和聚合服务器的时钟误差的上限(毫秒)，用请求中的 sent_ms 估计收到请求的时间，小于 0 表示不使用 sent_ms");
+DEFINE_int32(work_thread_num, 8, "RPC 工作线程数");
+DEFINE_int32(max_page_size, 100, "一次请求最多返回的结果数，和分片服务器保持一致");
+DEFINE_int32(max_result_window, 1000, "最多可以翻到的结果数，和分片服务器保持一致");
+
+namespace doc_server
+{
+
+typedef doc_server_proto::Request Request;
+typedef doc_server_proto::Response Response;
+typedef doc_server_proto::AddDocumentRequest AddDocumentRequest;
+typedef doc_server_proto::AddDocumentResponse AddDocumentResponse;
+typedef doc_server_proto::DeleteDocumentRequest DeleteDocumentRequest;
+typedef doc_server_proto::DeleteDocumentResponse DeleteDocumentResponse;
+typedef doc_server_proto::BatchRequest BatchRequest;
+typedef doc_server_proto::BatchResponse BatchResponse;
+typedef doc_server_proto::ReloadIndexRequest ReloadIndexRequest;
+typedef doc_server_proto::ReloadIndexResponse ReloadIndexResponse;
+
+//聚合服务器的接口和单机服务器完全一样，客户端不需要区分
+class AggregatorAPIImpl : public doc_server_proto::DocServerAPI
+{
+public:
+        explicit AggregatorAPIImpl(Aggregator* aggregator)
+            : aggregator_(aggregator)
+        {}
+
+        void Search(::google::protobuf::RpcController* controller, const Request* req, Response* resp,::google::protobuf::Closure* done)
+        {
+            (void) controller;
+            //在 RPC 队列中排队的时间也算在超时时间中
+            aggregator_->Search(*req, resp,
+                                common::TimeUtil::EstimateReceivedMS(req->sent_ms(), fLI::FLAGS_max_clock_skew_ms));
+            done->Run();
+        }
+
+        void AddDocument(::google::protobuf::RpcController* controller, const AddDocumentRequest* req,
+                         AddDocumentResponse* resp, ::google::protobuf::Closure* done)
+        {
+            (void) controller;
+            aggregator_->AddDocument(*req, resp);
+            done->Run();
+        }
+
+        void DeleteDocument(::google::protobuf::RpcController* controller, const DeleteDocumentRequest* req,
+                            DeleteDocumentResponse* resp, ::google::protobuf::Closure* done)
+        {
+            (void) controller;
+            aggregator_->DeleteDocument(*req, resp);
+            done->Run();
+        }
+
+        //批量查询依次处理每个查询，每个查询在各个分片上是并行的
+        void BatchSearch(::google::protobuf::RpcController* controller, const BatchRequest* req,
+                         BatchResponse* resp, ::google::protobuf::Closure* done)
+        {
+            (void) controller;
+            resp->set_sid(req->sid());
+            resp->set_timestamp(common::TimeUtil::TimeStamp());
+            //每个查询的超时时间都从收到批量请求时开始计算
+            int64_t received_ms = common::TimeUtil::EstimateReceivedMS(req->sent_ms(), fLI::FLAGS_max_clock_skew_ms);
+            for(const auto& request : req->request())
+            {
+                aggregator_->Search(request, resp->add_response(), received_ms);
+            }
+            resp->set_err_code(0);
+            done->Run();
+        }
+
+        void ReloadIndex(::google::protobuf::RpcController* controller, const ReloadIndexRequest* req,
+                         ReloadIndexResponse* resp, ::google::protobuf::Closure* done)
+        {
+            (void) controller;
+            aggregator_->ReloadIndex(*req, resp);
+            done->Run();
+        }
+
+private:
+        Aggregator* aggregator_;
+};
+
+} //end doc_server
+
+
+int main(int argc, char* argv[])
+{
+    google::InitGoogleLogging(argv[0]);
+  	fLS::FLAGS_log_dir = "../log/";
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    using namespace sofa::pbrpc;
+
+    //1. 和每个分片服务器建立连接，所有的分片共用一个 RpcClient
+    std::vector<std::string> shard_addrs;
+    common::StringUtil::Split(fLS::FLAGS_shard_addrs, &shard_addrs, ",");
+    RpcClient client;
+    std::vector<std::unique_ptr<RpcChannel>> channels;
+    std::vector<std::unique_ptr<doc_server_proto::DocServerAPI_Stub>> stubs;
+    std::vector<doc_server_proto::DocServerAPI*> shards;
+    for(const auto& addr : shard_addrs)
+    {
+        channels.emplace_back(new RpcChannel(&client, addr));
+        stubs.emplace_back(new doc_server_proto::DocServerAPI_Stub(channels.back().get()));
+        shards.push_back(stubs.back().get());
+    }
+    LOG(INFO) << "shard_num=" << shards.size();
+    doc_server::Aggregator aggregator(shards, fLI::FLAGS_shard_timeout_ms,
+                                      fLI::FLAGS_shard_update_timeout_ms, fLI::FLAGS_shard_reload_timeout_ms,
+                                      std::max(fLI::FLAGS_max_page_size, 0),
+                                      std::max(fLI::FLAGS_max_result_window, 0));
+
+    //2. 启动 RPC 服务器
+    RpcServerOptions option;
+    option.work_thread_num = fLI::FLAGS_work_thread_num;
+    RpcServer server(option);
+    CHECK(server.Start("0.0.0.0:" + fLS::FLAGS_port));
+    server.RegisterService(new doc_server::AggregatorAPIImpl(&aggregator));
+    server.Run();
+    return 0;
+}
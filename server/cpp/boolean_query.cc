@@ -0,0 +1,199 @@
+#include "boolean_query.h"
+#include <algorithm>
+#include <limits>
+
+
+namespace doc_server
+{
+
+static const uint64_t kEndDocId = (uint64_t)std::numeric_limits<uint32_t>::max() + 1;
+
+void BooleanRetriever::AddGroup(const std::vector<TermCursor*>& cursors)
+{
+    Group group;
+    group.cursors = cursors;
+    group.size = 0;
+    for(const TermCursor* cursor : cursors)
+    {
+        group.size += cursor->size();
+    }
+    groups_.push_back(group);
+}
+
+void BooleanRetriever::AddPhrase(const std::vector<size_t>& groups, const std::vector<uint32_t>& offsets,
+                                 uint32_t slop)
+{
+    Phrase phrase;
+    phrase.groups = groups;
+    phrase.offsets = offsets;
+    phrase.slop = slop;
+    phrases_.push_back(phrase);
+}
+
+uint64_t BooleanRetriever::GroupDocId(const Group& group)
+{
+    uint64_t doc_id = kEndDocId;
+    for(const TermCursor* cursor : group.cursors)
+    {
+        if(cursor->Valid())
+        {
+            doc_id = std::min<uint64_t>(doc_id, cursor->doc_id());
+        }
+    }
+    return doc_id;
+}
+
+void BooleanRetriever::GroupSkipTo(Group* group, uint64_t doc_id)
+{
+    for(TermCursor* cursor : group->cursors)
+    {
+        if(cursor->Valid() && cursor->doc_id() < doc_id)
+        {
+            cursor->SkipTo(doc_id);
+        }
+    }
+}
+
+//第 i 个词能出现的位置是：前一个词能出现的某个位置 q 之后的 [q + d, q + d + slop]，
+//d 为两个词在查询中的距离。每个词的位置都是升序的，两个指针同时往后走一遍就可以了
+bool BooleanRetriever::MatchPhrase(const Phrase& phrase, uint32_t doc_id)
+{
+    positions_.resize(phrase.groups.size());
+    for(size_t i = 0; i < phrase.groups.size(); ++i)
+    {
+        const Group& group = groups_[phrase.groups[i]];
+        const TermCursor* cursor = NULL;
+        for(const TermCursor* c : group.cursors)
+        {
+            if(c->Valid() && c->doc_id() == doc_id)
+            {
+                cursor = c;
+                break;
+            }
+        }
+        if(cursor == NULL || !cursor->positions(&positions_[i]))
+        {
+            //没有位置索引，只要求包含所有的词
+            return true;
+        }
+    }
+
+    //reach 为当前的词所有可能出现的位置
+    std::vector<uint32_t>& reach = positions_[0];
+    for(size_t i = 1; i < phrase.groups.size(); ++i)
+    {
+        uint32_t dist = phrase.offsets[i] - phrase.offsets[i - 1];
+        next_.clear();
+        size_t j = 0;
+        for(uint32_t pos : positions_[i])
+        {
+            while(j < reach.size() && (uint64_t)reach[j] + dist + phrase.slop < pos)
+            {
+                ++j;
+            }
+            if(j < reach.size() && (uint64_t)reach[j] + dist <= pos)
+            {
+                next_.push_back(pos);
+            }
+        }
+        if(next_.empty())
+        {
+            return false;
+        }
+        reach.swap(next_);
+    }
+    return true;
+}
+
+uint64_t BooleanRetriever::Search(size_t k, std::vector<ScoredDoc>* results, Deadline* deadline)
+{
+    results->clear();
+    if(groups_.empty())
+    {
+        return 0;
+    }
+    //最短的组放在最前面，由它产生候选文档，跳得最远的组最先被检查
+    //短语中记录的是组的下标，组本身不能移动
+    std::vector<Group*> groups;
+    for(Group& group : groups_)
+    {
+        groups.push_back(&group);
+    }
+    std::sort(groups.begin(), groups.end(),
+              [](const Group* g1, const Group* g2)
+              {
+                  return g1->size < g2->size;
+              });
+    doc_index::Index* index = doc_index::Index::Instance();
+    TopKCollector top_k(k);
+    uint64_t hits = 0;
+    uint64_t candidate = GroupDocId(*groups[0]);
+    while(candidate < kEndDocId)
+    {
+        if(deadline != NULL && deadline->Check())
+        {
+            break;
+        }
+        //1. 其他组依次跳到候选文档上
+        bool matched = true;
+        for(size_t i = 1; i < groups.size(); ++i)
+        {
+            GroupSkipTo(groups[i], candidate);
+            uint64_t doc_id = GroupDocId(*groups[i]);
+            if(doc_id != candidate)
+            {
+                //这个组中没有候选文档，它停下的位置之前的文档都不可能命中所有的组
+                GroupSkipTo(groups[0], doc_id);
+                candidate = GroupDocId(*groups[0]);
+                matched = false;
+                break;
+            }
+        }
+        if(!matched)
+        {
+            continue;
+        }
+
+        //2. 所有组都停在候选文档上，检查短语，要在游标往后走之前读取位置
+        for(size_t i = 0; matched && i < phrases_.size(); ++i)
+        {
+            matched = MatchPhrase(phrases_[i], candidate);
+        }
+
+        //3. 累加停在这个文档上的游标的得分，这些游标都往后走一步
+        ScoredDoc doc;
+        doc.doc_id = (uint32_t)candidate;
+        doc.score = 0;
+        doc.first_pos = -1;
+        int32_t best_score = -1;
+        for(Group& group : groups_)
+        {
+            for(TermCursor* cursor : group.cursors)
+            {
+                if(!cursor->Valid() || cursor->doc_id() != candidate)
+                {
+                    continue;
+                }
+                int32_t score = cursor->score();
+                doc.score += score;
+                if(score > best_score)
+                {
+                    best_score = score;
+                    doc.first_pos = cursor->first_pos();
+                }
+                cursor->Next();
+            }
+        }
+        if(matched && !index->IsDeleted(doc.doc_id) && !exclude_.Match(doc.doc_id))
+        {
+            ++hits;
+            top_k.Push(doc);
+        }
+        candidate = GroupDocId(*groups[0]);
+    }
+
+    top_k.Take(results);
+    return hits;
+}
+
+} //end doc_server
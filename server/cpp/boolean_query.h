@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+#include "wand.h"
+
+
+namespace doc_server
+{
+
+//布尔查询的检索：所有的组都要命中(AND)，组内的游标命中任意一个即可(OR)，
+//命中排除游标的文档去掉(NOT)，文档的得分为所有命中的查询词的得分之和
+//按照文档id的顺序遍历：从最短的组开始产生候选文档，其他组依次跳到(SkipTo)候选文档上，
+//某个组跳过了候选文档，就以它停下的文档id作为新的候选，直到所有组都停在同一个文档上。
+//跳转时先根据块头跳过整块，块内再倍增步长查找，不需要的块不解压，
+//所以求交集的代价和最短的拉链相关，而不是和所有拉链的总长度相关
+//短语只在所有的组都命中之后才检查，只需要读取这些文档的位置索引
+class BooleanRetriever
+{
+public:
+    //添加一组游标，组内是 OR 的关系
+    void AddGroup(const std::vector<TermCursor*>& cursors);
+
+    void AddExcludeCursor(TermCursor* cursor)
+    {
+        exclude_.AddCursor(cursor);
+    }
+
+    //添加一个短语，短语中的第 i 个词是第 groups[i] 组(按照 AddGroup 的顺序)，
+    //在查询中的位置为 offsets[i]，每个词和前一个词的距离最多可以比查询中多 slop
+    //没有位置索引的拉链不检查短语
+    void AddPhrase(const std::vector<size_t>& groups, const std::vector<uint32_t>& offsets, uint32_t slop);
+
+    //检索得分最高的 k 个文档，按照得分降序(得分相同时文档id升序)放到 results 中
+    //返回命中的文档总数，已经删除的文档不参与排序也不计数
+    //deadline 不为 NULL 时，时间用完之后提前结束，返回的命中数只包含已经检查过的文档
+    uint64_t Search(size_t k, std::vector<ScoredDoc>* results, Deadline* deadline = NULL);
+
+private:
+    struct Group
+    {
+        std::vector<TermCursor*> cursors;
+        uint64_t size; //组内所有拉链的文档数之和
+    };
+
+    struct Phrase
+    {
+        std::vector<size_t> groups;
+        std::vector<uint32_t> offsets;
+        uint32_t slop;
+    };
+
+    //组内所有游标中最小的文档id，都遍历完时返回 kMaxDocId + 1
+    static uint64_t GroupDocId(const Group& group);
+    static void GroupSkipTo(Group* group, uint64_t doc_id);
+    //所有的组都停在 doc_id 上时，检查文档是否包含短语
+    bool MatchPhrase(const Phrase& phrase, uint32_t doc_id);
+
+    std::vector<Group> groups_;
+    std::vector<Phrase> phrases_;
+    ExcludeFilter exclude_;
+    //每个词在当前文档中的位置
+    std::vector<std::vector<uint32_t>> positions_;
+    std::vector<uint32_t> next_;
+};
+
+} //end doc_server
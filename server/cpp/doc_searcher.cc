@@ -1,7 +1,27 @@
 #include "doc_searcher.h"
+#include <algorithm>
+#include <cstdlib>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <base/base.h>
+#include "accumulator.h"
+#include "boolean_query.h"
+#include "snippet.h"
 
 DEFINE_int32(desc_max_size, 160, "描述的最大长度");
+DEFINE_string(desc_highlight_pre, "<em>", "描述中高亮的查询词前面加的标签");
+DEFINE_string(desc_highlight_post, "</em>", "描述中高亮的查询词后面加的标签");
+DEFINE_bool(use_wand, true, "使用 Block-Max WAND 检索得分最高的文档，false 时对所有触发的文档打分排序");
+DEFINE_int32(max_page_size, 100, "一次请求最多返回的结果数");
+DEFINE_int32(max_result_window, 1000, "最多可以翻到的结果数，offset + num 超过时截断");
+DEFINE_bool(default_and, true, "查询中空白分开的各个部分都要命中，false 时命中任意一个即可");
+DEFINE_int32(max_phrase_slop, 16, "短语中相邻的两个词之间最多允许多出来的词数");
+DEFINE_int32(result_cache_size, 10000, "查询结果缓存的条数，0 表示不缓存");
+DEFINE_int32(result_cache_shard_num, 16, "查询结果缓存的分片数");
+DEFINE_int32(result_cache_ttl_ms, 60000, "查询结果缓存的有效时间(毫秒)，0 表示不过期");
+DEFINE_int32(max_batch_size, 10000, "一次批量查询最多包含的查询数");
+DEFINE_int32(search_time_budget_ms, 0, "一个查询最多的处理时间(毫秒)，用完之后返回已经找到的结果，0 表示不限制");
 
 namespace doc_server
 {
@@ -10,79 +30,635 @@ namespace doc_server
 //req中主要包含请求字符串query
 //resp中主要包含item数组
 //item中为标题，正文描述，跳转、展示url
-bool DocSearcher::Search(const Request& req, Response* resp)
+bool DocSearcher::Search(const Request& req, Response* resp, int64_t received_ms)
 {
     //context里面包含请求和响应，以及
     //请求的分词结果(用vector保存)和分词
-    //结果对应的所有倒排拉链(Weight*数组)
-    Context context(&req, resp);
+    //结果对应的所有倒排拉链
+    Context& context = context_;
+    context.Reset(&req, resp, RequestDeadline(req, received_ms));
+    //开始处理时已经过了截止时间，客户端已经不再等待，直接丢弃，不占用 CPU
+    //服务器过载时排队的请求很多(RPC 队列中的、批量查询中排在后面的)，这样可以尽快处理完积压的请求
+    if(context.deadline.Now())
+    {
+        LOG(WARNING) << "Search request expired! sid=" << req.sid() << " timeout_ms=" << req.timeout_ms();
+        resp->set_sid(req.sid());
+        resp->set_timestamp(common::TimeUtil::TimeStamp());
+        resp->set_err_code(-3);
+        return false;
+    }
+    //整个请求使用同一份索引，处理过程中重新加载索引不影响这个请求
+    //版本要在固定快照之前取，固定之后才加载完成的新索引增加的版本不会被记到旧索引的结果上
+    context.version = Index::Instance()->version();
+    Index::SnapshotGuard snapshot(Index::Instance());
+    //0. 计算需要返回的结果范围
+    InitPage(&context);
     //1. 对查询词进行分词
     CutQuery(&context);
-    //2. 根据分词结果进行触发
-    Retrieve(&context);
-    // 3. 根据触发结果进行排序
-    Rank(&context);
-    // 4. 根据排序结果进行包装响应
-    PackageResponse(&context);
+    //   热门的查询占了大部分请求，分词结果相同的请求直接使用缓存的结果
+    GenCacheKey(&context);
+    if(!GetCache(&context))
+    {
+        //2. 根据分词结果进行触发
+        Retrieve(&context);
+        // 3. 根据触发结果进行排序
+        Rank(&context);
+        // 4. 根据排序结果进行包装响应
+        PackageResponse(&context);
+        PutCache(&context);
+    }
     // 5. 记录处理日志
     Log(&context);
     return true;
 }
 
-//对查询词进行分词
+int64_t DocSearcher::RequestDeadline(const Request& req, int64_t received_ms)
+{
+    int64_t deadline_ms = 0;
+    if(req.timeout_ms() > 0)
+    {
+        deadline_ms = (received_ms > 0 ? received_ms : common::TimeUtil::TimeStampMS()) + req.timeout_ms();
+    }
+    if(fLI::FLAGS_search_time_budget_ms > 0)
+    {
+        int64_t budget_deadline_ms = common::TimeUtil::TimeStampMS() + fLI::FLAGS_search_time_budget_ms;
+        if(deadline_ms <= 0 || budget_deadline_ms < deadline_ms)
+        {
+            deadline_ms = budget_deadline_ms;
+        }
+    }
+    return std::max<int64_t>(deadline_ms, 0);
+}
+
+DocSearcher* DocSearcher::ThreadLocal()
+{
+    static thread_local DocSearcher searcher;
+    return &searcher;
+}
+
+//批量查询的共享状态，线程池中的任务可能在所有查询都完成之后才开始执行，
+//所以由 shared_ptr 持有，这样的任务取不到查询，不会再访问请求和响应
+struct BatchState
+{
+    std::atomic<int> next; //下一个要处理的查询
+    int done;              //已经完成的查询数
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<const Request*> reqs;
+    std::vector<Response*> resps;
+    int64_t received_ms;   //收到批量请求的时间，每个查询的超时时间都从这时开始计算
+};
+
+//不停地取下一个查询来处理，直到取完
+static void RunBatch(const std::shared_ptr<BatchState>& state)
+{
+    int n = state->reqs.size();
+    int finished = 0;
+    for(int i = state->next++; i < n; i = state->next++)
+    {
+        DocSearcher::ThreadLocal()->Search(*state->reqs[i], state->resps[i], state->received_ms);
+        ++finished;
+    }
+    if(finished == 0)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->done += finished;
+    if(state->done == n)
+    {
+        state->cond.notify_all();
+    }
+}
+
+//每个查询的处理和单独的 Search 一样，
+//查询不是事先平均分好的，哪个线程空闲就取下一个，查询的耗时不均匀时也能分得比较平均
+void DocSearcher::BatchSearch(const BatchRequest& req, BatchResponse* resp, common::ThreadPool* pool,
+                              int64_t received_ms)
+{
+    resp->set_sid(req.sid());
+    resp->set_timestamp(common::TimeUtil::TimeStamp());
+    int n = req.request_size();
+    if(n > fLI::FLAGS_max_batch_size)
+    {
+        LOG(ERROR) << "BatchSearch too many requests! sid=" << req.sid() << " n=" << n;
+        resp->set_err_code(-1);
+        return;
+    }
+    resp->set_err_code(0);
+    std::shared_ptr<BatchState> state(new BatchState());
+    state->next = 0;
+    state->done = 0;
+    state->received_ms = received_ms > 0 ? received_ms : common::TimeUtil::TimeStampMS();
+    for(int i = 0; i < n; ++i)
+    {
+        state->reqs.push_back(&req.request(i));
+        state->resps.push_back(resp->add_response());
+    }
+    //调用的线程也处理查询，只需要 n - 1 个任务
+    size_t task_cnt = std::min<size_t>(pool == NULL ? 0 : pool->thread_num(), std::max(n - 1, 0));
+    for(size_t i = 0; i < task_cnt; ++i)
+    {
+        pool->Submit(std::bind(RunBatch, state));
+    }
+    RunBatch(state);
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cond.wait(lock, [&state, n]{ return state->done == n; });
+    LOG(INFO) << "BatchSearch Done! sid=" << req.sid() << " n=" << n;
+}
+
+//key 中依次是每个查询词和它所在的组、排除词、短语和分页参数，
+//词的前面加上长度，不同的查询不会得到同样的 key
+void DocSearcher::GenCacheKey(Context* context)
+{
+    std::string& key = context->cache_key;
+    key.clear();
+    for(const auto& term : context->terms)
+    {
+        key.append(std::to_string(term.word.size())).append(":").append(term.word);
+        key.append("@").append(std::to_string(term.group)).append(" ");
+    }
+    key.append("|");
+    for(const auto& term : context->exclude_terms)
+    {
+        key.append(std::to_string(term.word.size())).append(":").append(term.word).append(" ");
+    }
+    key.append("|");
+    for(const auto& phrase : context->phrases)
+    {
+        for(size_t i = 0; i < phrase.terms.size(); ++i)
+        {
+            key.append(std::to_string(phrase.terms[i])).append("@").append(std::to_string(phrase.offsets[i]));
+            key.append(" ");
+        }
+        key.append("~").append(std::to_string(phrase.slop)).append(" ");
+    }
+    key.append("|").append(std::to_string(context->offset));
+    key.append(",").append(std::to_string(context->limit));
+    key.append(context->req->doc_only() ? "d" : "");
+}
+
+ResultCache* DocSearcher::GetResultCache()
+{
+    static ResultCache cache(std::max(fLI::FLAGS_result_cache_size, 0),
+                             std::max(fLI::FLAGS_result_cache_shard_num, 1),
+                             std::max(fLI::FLAGS_result_cache_ttl_ms, 0));
+    return &cache;
+}
+
+bool DocSearcher::GetCache(Context* context)
+{
+    //版本在检索之前已经取好，检索过程中索引发生变化时，放进缓存的结果是旧版本的，下次就会失效
+    if(fLI::FLAGS_result_cache_size <= 0)
+    {
+        return false;
+    }
+    CachedResult cached;
+    if(!GetResultCache()->Get(context->cache_key, &cached) || cached.version != context->version)
+    {
+        return false;
+    }
+    Response* resp = context->resp;
+    resp->CopyFrom(*cached.resp);
+    resp->set_sid(context->req->sid());
+    resp->set_timestamp(common::TimeUtil::TimeStamp());
+    context->cache_hit = true;
+    return true;
+}
+
+void DocSearcher::PutCache(Context* context)
+{
+    //提前结束的结果不完整，不能缓存
+    if(fLI::FLAGS_result_cache_size <= 0 || context->deadline.expired())
+    {
+        return;
+    }
+    CachedResult cached;
+    cached.version = context->version;
+    cached.resp.reset(new Response(*context->resp));
+    GetResultCache()->Put(context->cache_key, cached);
+}
+
+//根据请求中的分页参数计算需要返回的结果范围
+//只有前 limit 个文档需要排序，只有 [offset, limit) 范围内的文档需要生成描述
+void DocSearcher::InitPage(Context* context)
+{
+    const Request* req = context->req;
+    //doc_only 的请求来自聚合服务器，要取每个分片的前 offset + num 个，只返回文档id，不受每页结果数的限制
+    int max_num = req->doc_only() ? fLI::FLAGS_max_result_window : fLI::FLAGS_max_page_size;
+    size_t num = std::min<size_t>(req->num(), std::max(max_num, 0));
+    context->limit = std::min<size_t>((size_t)req->offset() + num, std::max(fLI::FLAGS_max_result_window, 0));
+    context->offset = std::min<size_t>(req->offset(), context->limit);
+}
+
+//对查询词进行分词，同时解析查询中的布尔操作：
+//  查询按照空白分成若干部分，每个部分都要命中(AND)；
+//  用 OR 连接起来的几个部分合成一个组，命中其中任意一个词即可；
+//  - 开头的部分是排除词，包含其中任意一个词的文档都不要(NOT)；
+//  一个部分分词之后得到多个词时，每个词都要命中；
+//  引号括起来的部分是短语，短语中的词要按照顺序相邻出现，"..."~N 允许相邻的词之间多出 N 个词，
+//  短语总是要命中的，不参与 OR
+//所有的词都在同一个组中时(比如 --default_and=false)，就是原来的按照相关性检索
 bool DocSearcher::CutQuery(Context* context)
 {
     // 调用当时索引结构栈总提供的接口
     // 因为直接调用只是分词，并不会
     // 去掉暂停词
     Index* index = Index::Instance();
-    index->CutWordWithoutStopWord(context->req->query(), &context->words);
+    std::vector<std::string>& parts = context->parts;
+    SplitQuery(context->req->query(), &parts);
+    std::vector<std::string> phrases;
+    //每个子句是 OR 连接起来的几个部分
+    std::vector<std::vector<std::string>> clauses;
+    std::vector<std::string>& words = context->words;
+    bool join = false;
+    for(const auto& part : parts)
+    {
+        if(part.empty())
+        {
+            continue;
+        }
+        if(part == "OR")
+        {
+            join = !clauses.empty();
+            continue;
+        }
+        if(part[0] == '"')
+        {
+            phrases.push_back(part);
+            join = false;
+            continue;
+        }
+        if(part[0] == '-' && part.size() > 1)
+        {
+            //排除的是短语中的每个词，而不是短语
+            std::string text = part.substr(1);
+            text.erase(std::remove(text.begin(), text.end(), '"'), text.end());
+            index->CutWordWithoutStopWord(text, &words);
+            for(const auto& word : words)
+            {
+                AddTerm(word, 0, &context->exclude_terms);
+            }
+            continue;
+        }
+        if(join)
+        {
+            clauses.back().push_back(part);
+        }
+        else
+        {
+            clauses.push_back(std::vector<std::string>(1, part));
+        }
+        join = false;
+    }
+
+    for(const auto& clause : clauses)
+    {
+        //OR 连接起来的部分的所有词都在同一组，--default_and=false 时所有的词都在同一组
+        bool one_group = clause.size() > 1 || !fLB::FLAGS_default_and;
+        bool new_group = fLB::FLAGS_default_and || context->group_cnt == 0;
+        for(const auto& part : clause)
+        {
+            index->CutWordWithoutStopWord(part, &words);
+            for(const auto& word : words)
+            {
+                if(new_group)
+                {
+                    ++context->group_cnt;
+                    new_group = !one_group;
+                }
+                AddTerm(word, context->group_cnt - 1, &context->terms);
+            }
+        }
+    }
+    for(const auto& phrase : phrases)
+    {
+        AddPhrase(phrase, context);
+    }
     LOG(INFO) << "CutQuery Done! sid=" << context->req->sid();
     return true;
 }
 
+//按照空白切分查询，引号中的空白不切分，短语后面的 ~N 和短语在同一个部分中
+void DocSearcher::SplitQuery(const std::string& query, std::vector<std::string>* parts)
+{
+    parts->clear();
+    std::string part;
+    bool quoted = false;
+    for(char c : query)
+    {
+        if(c == '"')
+        {
+            quoted = !quoted;
+        }
+        if(!quoted && (c == ' ' || c == '\t'))
+        {
+            if(!part.empty())
+            {
+                parts->push_back(part);
+                part.clear();
+            }
+            continue;
+        }
+        part.push_back(c);
+    }
+    if(!part.empty())
+    {
+        parts->push_back(part);
+    }
+}
+
+//part 的格式为 "词 词 ..." 或者 "词 词 ..."~N，短语中的每个词都单独是一组，
+//只有一个词的短语就是一个普通的词
+void DocSearcher::AddPhrase(const std::string& part, Context* context)
+{
+    size_t end = part.find('"', 1);
+    std::string text = part.substr(1, end == std::string::npos ? std::string::npos : end - 1);
+    uint32_t slop = 0;
+    if(end != std::string::npos && end + 1 < part.size() && part[end + 1] == '~')
+    {
+        //间隔不能超过标题和正文之间空出来的位置
+        int32_t max_slop = std::min<int32_t>(fLI::FLAGS_max_phrase_slop, doc_index::kFieldGap - 1);
+        slop = std::max(0, std::min(atoi(part.c_str() + end + 2), max_slop));
+    }
+    Phrase phrase;
+    std::vector<std::string>& words = context->words;
+    Index::Instance()->CutWordWithoutStopWord(text, &words, &phrase.offsets);
+    for(const auto& word : words)
+    {
+        phrase.terms.push_back(context->terms.size());
+        AddTerm(word, context->group_cnt++, &context->terms);
+    }
+    if(words.size() > 1)
+    {
+        phrase.slop = slop;
+        context->phrases.push_back(phrase);
+    }
+}
+
+//把一个查询词加到 terms 中
+void DocSearcher::AddTerm(const std::string& word, size_t group, std::vector<QueryTerm>* terms)
+{
+    terms->push_back(QueryTerm());
+    terms->back().word = word;
+    terms->back().group = group;
+}
+
 //根据查询词结果进行触发
 bool DocSearcher::Retrieve(Context* context)
 {
     Index* index = Index::Instance();
     //根据分词结果，到索引中找到所有的倒排拉链
-    //然后将倒排拉链插入到context中的
-    //all_query_chain(用来保存所有weight的数组)
-    for(const auto& word : context->words)
+    for(auto* terms : {&context->terms, &context->exclude_terms})
+    {
+        for(auto& term : *terms)
+        {
+            //实时段中的倒排拉链拷贝出来
+            index->GetRealtimeInvertedList(term.word, &term.realtime_list);
+            if(!index->GetInvertedList(term.word, &term.posting_list, &term.position_list))
+            {
+                //该分词结果如果没有对应的倒排拉链，继续
+                //不影响其他的
+                LOG(INFO) << "inverted_list NULL" << term.word;
+            }
+            //包含这个词的文档数，索引文件和实时段中的都要算上
+            index->GetScorer(term.posting_list.size() + term.realtime_list.size(), &term.scorer);
+        }
+    }
+
+    if(context->group_cnt > 1)
+    {
+        return RetrieveBoolean(context);
+    }
+    if(fLB::FLAGS_use_wand)
+    {
+        return RetrieveTopK(context);
+    }
+
+    //一个拉链一个拉链地把得分累加到每个文档上(term-at-a-time)，
+    //一个文档命中多个查询词时得分是这些词的得分之和，每个文档只出现一次
+    //累加器每个线程一个，大小为文档数，在请求之间复用
+    static thread_local ScoreAccumulator accumulator;
+    accumulator.Reset(index->DocIdLimit());
+    //每次处理一个块：解压，取出这些文档的长度，再一次算出整个块的得分
+    uint32_t doc_ids[doc_index::kPostingBlockSize];
+    uint32_t title_tf[doc_index::kPostingBlockSize];
+    uint32_t content_tf[doc_index::kPostingBlockSize];
+    int32_t first_pos[doc_index::kPostingBlockSize];
+    doc_index::DocLength lengths[doc_index::kPostingBlockSize];
+    int32_t scores[doc_index::kPostingBlockSize];
+    //时间用完时后面的块不再累加，得分只包含已经处理过的部分
+    Deadline& deadline = context->deadline;
+    for(const auto& term : context->terms)
+    {
+        const doc_index::PostingList& posting_list = term.posting_list;
+        for(size_t block = 0; block < posting_list.block_cnt() && !deadline.Check(doc_index::kPostingBlockSize); ++block)
+        {
+            size_t len = posting_list.DecodeBlock(block, doc_ids, title_tf, content_tf, first_pos);
+            index->GetDocLengths(doc_ids, len, lengths);
+            term.scorer.Score(title_tf, content_tf, lengths, len, scores);
+            for(size_t i = 0; i < len; ++i)
+            {
+                accumulator.Add(doc_ids[i], scores[i], first_pos[i]);
+            }
+        }
+
+        const doc_index::InvertedList& realtime_list = term.realtime_list;
+        for(size_t beg = 0; beg < realtime_list.size() && !deadline.Check(doc_index::kPostingBlockSize); beg += doc_index::kPostingBlockSize)
+        {
+            size_t len = std::min(doc_index::kPostingBlockSize, realtime_list.size() - beg);
+            index->GetDocLengths(&realtime_list.doc_ids[beg], len, lengths);
+            term.scorer.Score(&realtime_list.title_tf[beg], &realtime_list.content_tf[beg], lengths, len, scores);
+            for(size_t i = 0; i < len; ++i)
+            {
+                accumulator.Add(realtime_list.doc_ids[beg + i], scores[i], realtime_list.first_pos[beg + i]);
+            }
+        }
+    }
+
+    //然后将每个文档的得分放到context中的
+    //all_query_chain(用来保存所有文档的数组)
+    ScoredDoc doc;
+    for(uint32_t doc_id : accumulator.touched())
     {
-        const doc_index::InvertedList* inverted_list = index->GetInvertedList(word);
-        if(inverted_list == NULL)
+        //跳过已经被删除或者被新版本替换掉的文档
+        if(index->IsDeleted(doc_id))
         {
-            //该分词结果如果没有对应的倒排拉链，继续
-            //不影响其他的
-            LOG(INFO) << "inverted_list NULL" << word;
             continue;
         }
-        for(size_t i = 0; i < inverted_list->size(); ++i)
+        doc.doc_id = doc_id;
+        doc.score = accumulator.score(doc_id);
+        doc.first_pos = accumulator.first_pos(doc_id);
+        context->all_query_chain.push_back(doc);
+    }
+    FilterExclude(context);
+    context->total_hits = context->all_query_chain.size();
+
+    return true;
+}
+
+//去掉命中排除词的文档，排除词的拉链是按照文档id升序的，
+//先把文档按照id排序，这样每个拉链只需要从前往后跳一遍
+void DocSearcher::FilterExclude(Context* context)
+{
+    if(context->exclude_terms.empty())
+    {
+        return;
+    }
+    ExcludeFilter exclude;
+    for(const auto& term : context->exclude_terms)
+    {
+        exclude.AddCursor(context->cursors.New(term.posting_list, &term.scorer));
+        exclude.AddCursor(context->cursors.New(&term.realtime_list, &term.scorer));
+    }
+    std::vector<ScoredDoc>& chain = context->all_query_chain;
+    std::sort(chain.begin(), chain.end(),
+              [](const ScoredDoc& d1, const ScoredDoc& d2)
+              {
+                  return d1.doc_id < d2.doc_id;
+              });
+    chain.erase(std::remove_if(chain.begin(), chain.end(),
+                               [&exclude](const ScoredDoc& doc)
+                               {
+                                   return exclude.Match(doc.doc_id);
+                               }),
+                chain.end());
+}
+
+bool DocSearcher::RetrieveTopK(Context* context)
+{
+    //索引文件和实时段中的每个拉链都是一个游标，一起参与 WAND
+    WandRetriever retriever;
+    for(const auto& term : context->terms)
+    {
+        if(term.posting_list.size() != 0)
+        {
+            retriever.AddCursor(context->cursors.New(term.posting_list, &term.scorer));
+        }
+        if(!term.realtime_list.empty())
         {
-            const auto& weight = (*inverted_list)[i];
-            context->all_query_chain.push_back(&weight);
+            retriever.AddCursor(context->cursors.New(&term.realtime_list, &term.scorer));
         }
     }
 
+    for(const auto& term : context->exclude_terms)
+    {
+        retriever.AddExcludeCursor(context->cursors.New(term.posting_list, &term.scorer));
+        retriever.AddExcludeCursor(context->cursors.New(&term.realtime_list, &term.scorer));
+    }
+
+    retriever.Search(context->limit, &context->all_query_chain, &context->deadline);
+    context->sorted = true;
+    //前 limit 名没有凑满时所有命中的文档都已经找到了，否则只能估计
+    if(context->all_query_chain.size() < context->limit)
+    {
+        context->total_hits = context->all_query_chain.size();
+    }
+    else
+    {
+        context->total_hits = EstimateHits(context);
+    }
+    return true;
+}
+
+//WAND 跳过了大部分文档，不知道准确的命中数，
+//假设各个查询词在文档中的出现是相互独立的，命中数约为 N * (1 - (1 - df1/N) * (1 - df2/N) ...)，
+//再乘上不包含排除词的比例
+//结果不会小于已经找到的文档数
+uint64_t DocSearcher::EstimateHits(const Context* context) const
+{
+    double doc_cnt = Index::Instance()->DocCnt();
+    if(doc_cnt == 0)
+    {
+        return context->all_query_chain.size();
+    }
+    double miss = 1.0;
+    for(const auto& term : context->terms)
+    {
+        double df = term.posting_list.size() + term.realtime_list.size();
+        miss *= 1.0 - std::min(df, doc_cnt) / doc_cnt;
+    }
+    //排除词同样按照独立估计，不包含任何一个排除词的比例
+    double keep = 1.0;
+    for(const auto& term : context->exclude_terms)
+    {
+        double df = term.posting_list.size() + term.realtime_list.size();
+        keep *= 1.0 - std::min(df, doc_cnt) / doc_cnt;
+    }
+    uint64_t estimate = (uint64_t)(doc_cnt * (1.0 - miss) * keep + 0.5);
+    return std::max<uint64_t>(estimate, context->all_query_chain.size());
+}
+
+//每组的游标是组内各个词在索引文件和实时段中的拉链，
+//求交集的过程中每个命中的文档都会被检查，命中数是准确的
+bool DocSearcher::RetrieveBoolean(Context* context)
+{
+    std::vector<std::vector<TermCursor*>> groups(context->group_cnt);
+    for(const auto& term : context->terms)
+    {
+        std::vector<TermCursor*>& group = groups[term.group];
+        if(term.posting_list.size() != 0)
+        {
+            group.push_back(context->cursors.New(term.posting_list, &term.scorer, term.position_list));
+        }
+        if(!term.realtime_list.empty())
+        {
+            group.push_back(context->cursors.New(&term.realtime_list, &term.scorer));
+        }
+    }
+    BooleanRetriever retriever;
+    for(const auto& group : groups)
+    {
+        retriever.AddGroup(group);
+    }
+    for(const auto& phrase : context->phrases)
+    {
+        std::vector<size_t> phrase_groups;
+        for(size_t i : phrase.terms)
+        {
+            phrase_groups.push_back(context->terms[i].group);
+        }
+        retriever.AddPhrase(phrase_groups, phrase.offsets, phrase.slop);
+    }
+    for(const auto& term : context->exclude_terms)
+    {
+        retriever.AddExcludeCursor(context->cursors.New(term.posting_list, &term.scorer));
+        retriever.AddExcludeCursor(context->cursors.New(&term.realtime_list, &term.scorer));
+    }
+
+    context->total_hits = retriever.Search(context->limit, &context->all_query_chain, &context->deadline);
+    context->sorted = true;
     return true;
 }
 
 //根据触发结果进行排序
 bool DocSearcher::Rank(Context* context)
 {
-    //虽然之前再索引结构中已经对每个倒排拉链排过序了
-    //但是all_query_chain保存了多个倒排拉链，所以还要
-    //对其进行排序，规则也是按照权重降序排序
-    std::sort(context->all_query_chain.begin(), context->all_query_chain.end(), CmpWeightPtr);
+    if(context->sorted)
+    {
+        //WAND 和求交集检索出来的结果已经是排好序的
+        return true;
+    }
+    //all_query_chain 中是每个文档累加之后的得分，
+    //只需要前 limit 个文档按照得分降序排好序，剩下的直接丢掉
+    std::vector<ScoredDoc>& chain = context->all_query_chain;
+    if(chain.size() > context->limit)
+    {
+        std::partial_sort(chain.begin(), chain.begin() + context->limit, chain.end(), CmpScore);
+        chain.resize(context->limit);
+    }
+    else
+    {
+        std::sort(chain.begin(), chain.end(), CmpScore);
+    }
 
     return true;
 }
 
-//排序需要的比较函数
-bool DocSearcher::CmpWeightPtr(const Weight* w1, const Weight* w2)
+//排序需要的比较函数，得分相同时文档id小的在前，和 WAND 的结果一致
+bool DocSearcher::CmpScore(const ScoredDoc& d1, const ScoredDoc& d2)
 {
-    return w1->weight() > w2->weight();
+    return d1.score > d2.score || (d1.score == d2.score && d1.doc_id < d2.doc_id);
 }
 
 //根据排序的结果拼装成响应
@@ -91,88 +667,172 @@ bool DocSearcher::PackageResponse(Context* context)
     //构造出最终的Response结构
     //resp中主要包含item数组
     //item中为标题，正文描述，跳转、展示url
-    Index* index = Index::Instance();
     const Request* req = context->req;
     Response* resp = context->resp;
     resp->set_sid(req->sid());
     resp->set_timestamp(common::TimeUtil::TimeStamp());
     resp->set_err_code(0);
+    resp->set_total_hits(context->total_hits);
+    resp->set_partial(context->deadline.expired());
 
-    //根据context中的all_query_chain中的weight结构，
+    //根据context中的all_query_chain中的文档，
+    //只取 [offset, limit) 范围内的文档，
     //拿到doc_id,再到正排索引中查找到文档的详细信息
     //doc_info(标题，正文，show_url，jump_url)
-    for(const auto* weight : context->all_query_chain) 
+    const std::vector<ScoredDoc>& chain = context->all_query_chain;
+    if(req->doc_only())
+    {
+        //聚合服务器合并各个分片的结果只需要文档id和得分，不用取正排
+        resp->set_index_generation(Index::Instance()->generation());
+        for(size_t i = context->offset; i < chain.size(); ++i)
+        {
+            auto* item = resp->add_item();
+            item->set_title("");
+            item->set_desc("");
+            item->set_show_url("");
+            item->set_jump_url("");
+            item->set_doc_id(chain[i].doc_id);
+            item->set_score(chain[i].score);
+            item->set_first_pos(chain[i].first_pos);
+        }
+        return true;
+    }
+    InitSnippet(context);
+    for(size_t i = context->offset; i < chain.size(); ++i)
+    {
+        if(!PackageItem(chain[i], context, resp->add_item()))
+        {
+            resp->mutable_item()->RemoveLast();
+        }
+    }
+    return true;
+}
+
+void DocSearcher::InitSnippet(Context* context)
+{
+    //描述优先选正文中包含查询词最多的一段
+    SnippetBuilder& snippet = context->snippet;
+    snippet.Reset(std::max(fLI::FLAGS_desc_max_size, 0),
+                  fLS::FLAGS_desc_highlight_pre, fLS::FLAGS_desc_highlight_post);
+    for(const QueryTerm& term : context->terms)
     {
-        const auto* doc_info = index->GetDocInfo(weight->doc_id());
-        //使用doc_info构建响应中的item(doc_info与item一一对应)
+        snippet.AddWord(term.word);
+    }
+}
+
+bool DocSearcher::PackageItem(const ScoredDoc& doc, Context* context, doc_server_proto::Item* item)
+{
+    //doc_info 中的字段直接指向索引文件中的数据，只有写到响应中的时候才拷贝
+    doc_index::DocView doc_info;
+    if(!Index::Instance()->GetDocInfo(doc.doc_id, &doc_info))
+    {
+        LOG(ERROR) << "GetDocInfo failed! doc_id=" << doc.doc_id;
+        return false;
+    }
+    //使用doc_info构建响应中的item(doc_info与item一一对应)
+    item->set_title(doc_info.title.data(), doc_info.title.size());
+    //item中的描述是根据doc_info中的正文生成的
+    //而不是直接将正文设置
+    //索引中保存了正文的分词结果时，选包含查询词最多的一段并高亮查询词，
+    //否则用得分最高的词在正文第一次出现的位置来构建
+    if(!context->snippet.Build(doc_info, item->mutable_desc()))
+    {
+        GenDesc(doc.first_pos, doc_info, item->mutable_desc());
+    }
+    item->set_jump_url(doc_info.jump_url.data(), doc_info.jump_url.size());
+    item->set_show_url(doc_info.show_url.data(), doc_info.show_url.size());
+    return true;
+}
+
+bool DocSearcher::FetchDocs(const FetchDocsRequest& req, Response* resp)
+{
+    //按照普通的查询分词，得到描述中要高亮的查询词，不用检索
+    Request query;
+    query.set_sid(req.sid());
+    query.set_timestamp(req.timestamp());
+    query.set_query(req.query());
+    Context& context = context_;
+    context.Reset(&query, resp);
+    Index::SnapshotGuard snapshot(Index::Instance());
+    resp->set_sid(req.sid());
+    resp->set_timestamp(common::TimeUtil::TimeStamp());
+    if(req.has_index_generation() && req.index_generation() != Index::Instance()->generation())
+    {
+        //两次请求之间重新加载了索引，文档id已经对应不上了
+        LOG(WARNING) << "FetchDocs index reloaded! sid=" << req.sid();
+        resp->set_err_code(-2);
+        return false;
+    }
+    resp->set_err_code(0);
+    CutQuery(&context);
+    InitSnippet(&context);
+    for(int i = 0; i < req.doc_size(); ++i)
+    {
+        ScoredDoc doc;
+        doc.score = 0;
+        doc.doc_id = req.doc(i).doc_id();
+        doc.first_pos = req.doc(i).first_pos();
         auto* item = resp->add_item();
-        item->set_title(doc_info->title());
-        //item中的描述是根据doc_info中的正文生成的
-        //而不是直接将正文设置
-        //这里在生成描述的时候，由于不知道是词与正文的对应
-        //关系，所以就用到了weight中词在正文第一次出现的位置
-        //来构建
-        item->set_desc(GenDesc(weight->first_pos(), doc_info->content()));
-        item->set_jump_url(doc_info->jump_url());
-        item->set_show_url(doc_info->show_url());
-    }
-    LOG(INFO) << resp->item_size();
+        if(!PackageItem(doc, &context, item))
+        {
+            item->Clear();
+            item->set_title("");
+            item->set_desc("");
+            item->set_show_url("");
+            item->set_jump_url("");
+        }
+    }
+    LOG(INFO) << "FetchDocs sid=" << req.sid() << " doc_cnt=" << req.doc_size();
     return true;
 }
 
 //这里描述的构建比较灵活，只要用户体验好，都行，
 //根据first_pos找到句子开始位置，然后设置描述最大
 //长度，描述就构建成功了
-std::string DocSearcher::GenDesc(int first_pos, const std::string& content)
+void DocSearcher::GenDesc(int first_pos, const doc_index::DocView& doc, std::string* desc)
 {
+    const common::StringPiece& content = doc.content;
     //1. 根据first_pos找到这句话的开始位置
-    //  通过标点符号来确定。
+    //  通过标点符号来确定，建索引时已经算好了句子的起始位置表
     int64_t desc_beg = 0;
     //这里first_pos可能不存在，表示这个词没在正文中出现过
     //如果是这只情况，直接从正文开始位置构建描述
     if(first_pos != -1)//表示存在
     {
-        desc_beg = common::StringUtil::FindSentenceBeg(content, first_pos);
+        desc_beg = doc.SentenceBeg(first_pos);
     }
     //2. 从句子开始的位置，往后去找若干字节(可以自定义)
-    std::string desc;
+    //由于返回的是html文件，所以需要将特殊字符替换成转义字符，
+    //转义时直接从正文追加到 desc 中，不需要先拷贝出来
+    desc->clear();
     //3. 如果句子开始到正文结束，长度毒狗
     //   自定义的描述长度，就将将整体作为描述
     if(desc_beg + fLI::FLAGS_desc_max_size >= (int32_t)content.size())
     {
         //没有结尾表示到string 的结尾
-        desc = content.substr(desc_beg);
+        common::StringUtil::AppendEscapeHtml(content.substr(desc_beg), desc);
     }
     else
     {
         //4. 如果句子开始到正文结尾超过自定义长度
         //   则将倒数三个字节改成...，类似于省略号
-        desc = content.substr(desc_beg, fLI::FLAGS_desc_max_size);
-        desc[desc.size() - 1] = '.';
-        desc[desc.size() - 2] = '.';
-        desc[desc.size() - 3] = '.';
+        int32_t len = std::max(fLI::FLAGS_desc_max_size - 3, 0);
+        common::StringUtil::AppendEscapeHtml(content.substr(desc_beg, len), desc);
+        desc->append("...");
     }
-
-    //由于返回的是html文件，所以需要将特殊字符
-    //替换成转义字符
-    ReplaceEscape(&desc);
-    return desc;
 }
 
-//替换html中的转义字符
-void DocSearcher::ReplaceEscape(std::string* desc)
-{
-    boost::algorithm::replace_all(*desc, "&", "&amp;");
-    boost::algorithm::replace_all(*desc, "\"", "&quot;");
-    boost::algorithm::replace_all(*desc, "<", "&lt;");
-    boost::algorithm::replace_all(*desc, ">", "&gt;");
-}
 //打印请求日志
 //生成描述信息
 bool DocSearcher::Log(Context* context)
 {
     LOG(INFO) << "[Request]" << context->req->Utf8DebugString();
     LOG(INFO) << "[Response]" << context->resp->Utf8DebugString();
+    ResultCache* cache = GetResultCache();
+    const doc_index::CutCache& cut_cache = Index::Instance()->cut_cache();
+    LOG(INFO) << "[Cache] hit=" << context->cache_hit << " total_hit=" << cache->hits()
+              << " total_miss=" << cache->misses() << " cut_hit=" << cut_cache.hits()
+              << " cut_miss=" << cut_cache.misses();
     return true;
 }
 
@@ -4,6 +4,10 @@
 #include <glog/logging.h>
 #include <gflags/gflags.h>
 #include "../../index/cpp/index.h"
+#include "../../common/lru_cache.hpp"
+#include "../../common/thread_pool.hpp"
+#include "wand.h"
+#include "snippet.h"
 
 
 namespace doc_server
@@ -11,24 +15,130 @@ namespace doc_server
     //服务器的proto文件中定义的类型
     typedef doc_server_proto::Request Request;
     typedef doc_server_proto::Response Response;
+    typedef doc_server_proto::BatchRequest BatchRequest;
+    typedef doc_server_proto::BatchResponse BatchResponse;
+    typedef doc_server_proto::FetchDocsRequest FetchDocsRequest;
     //index的proto文件中定义的类型
-    typedef doc_index_proto::Weight Weight;
     typedef doc_index::Index Index;
 
+//一个查询词在索引中的数据
+struct QueryTerm
+{
+    std::string word;
+    //所在的组，所有的组都要命中，同一组内的词命中任意一个即可
+    size_t group;
+    //在索引文件中的倒排拉链(不存在的词为空)
+    doc_index::PostingList posting_list;
+    //索引文件中的位置索引，短语查询使用
+    doc_index::PositionList position_list;
+    //在实时段中的倒排拉链，从实时段中拷贝出来的
+    doc_index::InvertedList realtime_list;
+    //这个词的打分器
+    doc_index::Bm25Scorer scorer;
+};
+
+//查询中用引号括起来的短语，短语中的词要按照顺序相邻出现
+struct Phrase
+{
+    //短语中每个词在 terms 中的下标，每个词单独是一组
+    std::vector<size_t> terms;
+    //每个词在查询的分词结果中的下标
+    std::vector<uint32_t> offsets;
+    //相邻的两个词之间最多可以多出来的词数，查询中用 "..."~slop 指定
+    uint32_t slop;
+};
+
+
+//缓存的查询结果
+struct CachedResult
+{
+    //计算结果时索引的版本，和当前的版本不一样时结果已经失效
+    uint64_t version;
+    //sid 和 timestamp 在命中的时候重新设置
+    std::shared_ptr<const Response> resp;
+};
+
+typedef common::ShardedLruCache<std::string, CachedResult> ResultCache;
 
 //请求的上下文信息
+//每个工作线程的 DocSearcher 持有一个，在请求之间复用，
+//Reset 时只清空内容，各个数组已经分配的空间留给下一个请求使用
 struct Context
 {
-    Context(const Request* request, Response* response)
-        : req(request)
-        , resp(response)
+    Context()
+        : req(NULL)
+        , resp(NULL)
+        , group_cnt(0)
+        , sorted(false)
+        , version(0)
+        , cache_hit(false)
+        , offset(0)
+        , limit(0)
+        , total_hits(0)
     {}
+
+    //开始处理一个新的请求，deadline_ms 为这个请求的截止时间(0 表示没有)
+    void Reset(const Request* request, Response* response, int64_t deadline_ms = 0)
+    {
+        req = request;
+        resp = response;
+        deadline.Reset(deadline_ms);
+        terms.clear();
+        exclude_terms.clear();
+        group_cnt = 0;
+        phrases.clear();
+        sorted = false;
+        cache_key.clear();
+        version = 0;
+        cache_hit = false;
+        all_query_chain.clear();
+        offset = 0;
+        limit = 0;
+        total_hits = 0;
+        parts.clear();
+        words.clear();
+        cursors.Clear();
+    }
+
     const Request* req;
     Response* resp;
-    //保存分词结果
+    //需要命中的词，每个分词结果一个
+    std::vector<QueryTerm> terms;
+    //需要排除的词(查询中 - 开头的部分)
+    std::vector<QueryTerm> exclude_terms;
+    //组的个数，只有一组时所有的词都是 OR 的关系
+    size_t group_cnt;
+    //查询中的短语
+    std::vector<Phrase> phrases;
+    //all_query_chain 是否已经按照得分排好序了
+    bool sorted;
+    //查询结果缓存的 key，由分词结果和分页参数组成
+    std::string cache_key;
+    //开始检索时索引的版本
+    uint64_t version;
+    //结果是否来自缓存
+    bool cache_hit;
+    //保存触发到的文档，每个文档只有一条
+    //ScoredDoc 只有 16 个字节，直接拷贝比保存指针排序时的缓存命中率更高
+    //排序之后只保留前 limit 个文档
+    std::vector<ScoredDoc> all_query_chain;
+    //本次请求返回排好序的第 [offset, limit) 个文档
+    size_t offset;
+    size_t limit;
+    //命中的文档总数
+    uint64_t total_hits;
+    //截止时间，时间用完之后检索提前结束，响应中设置 partial
+    Deadline deadline;
+
+    //以下是处理过程中使用的缓冲区
+    //查询按照空白切分之后的各个部分
+    std::vector<std::string> parts;
+    //一个部分的分词结果
     std::vector<std::string> words;
-    //保存触发到的倒排拉链的结果集合
-    std::vector<const Weight*> all_query_chain;
+    //检索时使用的游标
+    CursorPool cursors;
+    //生成描述
+    SnippetBuilder snippet;
 };
 
 //这个类是完成搜索的和心类
@@ -36,24 +146,68 @@ class DocSearcher
 {
 public:
     //搜索流程的入口函数
-    bool Search(const Request& req, Response* resp);
+    //同一个 DocSearcher 可以处理多个请求(不能同时)，请求之间复用 context_ 中的缓冲区
+    //received_ms 为收到请求的时间(毫秒时间戳)，请求的 timeout_ms 从这时开始计算，0 表示现在
+    bool Search(const Request& req, Response* resp, int64_t received_ms = 0);
+
+    //当前线程的 DocSearcher，同一个线程处理的请求都用它
+    static DocSearcher* ThreadLocal();
+
+    //批量查询，把查询分给 pool 中的线程同时处理，调用的线程也参与，所有查询都完成之后返回
+    //received_ms 为收到批量请求的时间，含义和 Search 的一样
+    static void BatchSearch(const BatchRequest& req, BatchResponse* resp, common::ThreadPool* pool,
+                            int64_t received_ms = 0);
+
+    //取一组文档的标题、描述和 url，分片部署时聚合服务器只对最终页面上的文档调用
+    //文档id来自 doc_only 的查询，索引在两次请求之间重新加载过时返回 false
+    bool FetchDocs(const FetchDocsRequest& req, Response* resp);
 private:
-    //对查询词进行分词
+    Context context_;
+
+    //请求的截止时间，取 收到请求的时间 + timeout_ms 和服务器限制的处理时间中早的一个，0 表示没有
+    static int64_t RequestDeadline(const Request& req, int64_t received_ms);
+    //根据请求中的分页参数计算需要返回的结果范围
+    void InitPage(Context* context);
+    //按照空白切分查询，引号中的空白不切分
+    static void SplitQuery(const std::string& query, std::vector<std::string>* parts);
+    //对查询词进行分词，同时解析查询中的 OR，- 和短语
     bool CutQuery(Context* context);
+    //把一个短语加到 context 中
+    void AddPhrase(const std::string& part, Context* context);
+    //把一个查询词加到 terms 中
+    void AddTerm(const std::string& word, size_t group, std::vector<QueryTerm>* terms);
+    //由分词结果和分页参数生成缓存的 key，同样的 key 得到的结果一定一样
+    void GenCacheKey(Context* context);
+    //在缓存中查找结果，找到时直接填好响应
+    bool GetCache(Context* context);
+    //把响应放到缓存中
+    void PutCache(Context* context);
+    //所有请求共享的查询结果缓存
+    static ResultCache* GetResultCache();
     //根据查询词结果进行触发
     bool Retrieve(Context* context);
+    //使用 WAND 直接检索出得分最高的前 limit 个文档
+    bool RetrieveTopK(Context* context);
+    //有多个组时，求所有组的交集
+    bool RetrieveBoolean(Context* context);
+    //去掉命中排除词的文档
+    void FilterExclude(Context* context);
+    //估计命中的文档总数
+    uint64_t EstimateHits(const Context* context) const;
     //根据触发结果进行排序
     bool Rank(Context* context);
     //根据排序的结果拼装成响应
     bool PackageResponse(Context* context);
-    //生成描述信息
-    std::string GenDesc(int first_pos, const std::string& content);
+    //用查询词初始化生成描述的 SnippetBuilder
+    void InitSnippet(Context* context);
+    //取文档的正排填到 item 中，文档不存在时返回 false
+    bool PackageItem(const ScoredDoc& doc, Context* context, doc_server_proto::Item* item);
+    //生成描述信息，直接写到 desc 中
+    void GenDesc(int first_pos, const doc_index::DocView& doc, std::string* desc);
     //打印请求日志
     bool Log(Context* context);
     //排序需要的比较函数
-    static bool CmpWeightPtr(const Weight* w1, const Weight* w2);
-    //替换html中的转义字符
-    void ReplaceEscape(std::string* desc);
+    static bool CmpScore(const ScoredDoc& d1, const ScoredDoc& d2);
 };
 
 }//end doc_server
@@ -1,3 +1,12 @@
+#include <atomic>
+#include <algorithm>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <sys/stat.h>
 #include <base/base.h>
 #include <sofa/pbrpc/pbrpc.h>
 #include "../../common/util.hpp"
@@ -7,16 +16,37 @@
 
 DEFINE_string(port, "10000", "服务器端口号");
 DEFINE_string(index_path, "../index/index_file","索引文件的路径");
+DEFINE_int32(work_thread_num, 0, "RPC 工作线程数，0 表示和进程可以使用的 CPU 核数相同");
+DEFINE_int32(batch_thread_num, 0, "批量查询使用的线程数，0 表示和进程可以使用的 CPU 核数相同");
+DEFINE_int32(index_watch_interval_s, 0, "检查索引文件是否更新的间隔(秒)，文件更新之后自动重新加载，0 表示不检查");
+DEFINE_string(reload_index_dir, "", "ReloadIndex 请求可以加载的索引文件所在的目录，为空时只能重新加载 --index_path");
+DEFINE_int32(max_clock_skew_ms, 50, "发送方和服务器的时钟误差的上限(毫秒)，用请求中的 sent_ms 估计收到请求的时间，小于 0 表示不使用 sent_ms");
+DEFINE_bool(bind_cpu, false, "把每个工作线程绑定到一个 CPU 核上，工作线程数不超过核数时每个核一个线程");
 
 namespace doc_server 
 {
 
 typedef doc_server_proto::Request Request;
 typedef doc_server_proto::Response Response;
+typedef doc_server_proto::AddDocumentRequest AddDocumentRequest;
+typedef doc_server_proto::AddDocumentResponse AddDocumentResponse;
+typedef doc_server_proto::DeleteDocumentRequest DeleteDocumentRequest;
+typedef doc_server_proto::DeleteDocumentResponse DeleteDocumentResponse;
+typedef doc_server_proto::BatchRequest BatchRequest;
+typedef doc_server_proto::BatchResponse BatchResponse;
+typedef doc_server_proto::ReloadIndexRequest ReloadIndexRequest;
+typedef doc_server_proto::ReloadIndexResponse ReloadIndexResponse;
+typedef doc_server_proto::FetchDocsRequest FetchDocsRequest;
 
 class DocServerAPIImpl : public doc_server_proto::DocServerAPI 
 {
 public:
+        //batch_pool 为批量查询使用的线程池，reload_pool 为重新加载索引使用的线程池(一个线程)
+        DocServerAPIImpl(common::ThreadPool* batch_pool, common::ThreadPool* reload_pool)
+            : batch_pool_(batch_pool)
+            , reload_pool_(reload_pool)
+        {}
+
         //客户端在本地调用的函数，实际上调用的是服务器本地
         //的函数，此函数是真正在服务器端完成计算的函数
         void Search(::google::protobuf::RpcController* controller, const Request* req, Response* resp,::google::protobuf::Closure* done) 
@@ -28,16 +58,211 @@ public:
             // resp->set_err_code(0);
 
             // 具体如何完成更详细的搜索计算, 一会再说
-            DocSearcher searcher;
-            searcher.Search(*req, resp);
+            // 每个工作线程一个 DocSearcher，请求之间复用其中的缓冲区
+            // 请求在 RPC 队列中排队的时间也算在超时时间中，服务器过载时排队的请求很多，
+            // 客户端已经不再等待的请求直接丢弃
+            int64_t received_ms = common::TimeUtil::EstimateReceivedMS(req->sent_ms(), fLI::FLAGS_max_clock_skew_ms);
+            DocSearcher::ThreadLocal()->Search(*req, resp, received_ms);
 
             // 这行代码表示服务器对这次请求的计算就完成了.
             // 由于 RPC 框架一般都是在服务器端异步完成计算,
             // 所以就需要由被调用的函数来通知调用者我计算完了.
             done->Run();
         }
+
+        //在线新增(或者更新)文档，文档进入索引的实时段，之后的搜索立即可见
+        void AddDocument(::google::protobuf::RpcController* controller, const AddDocumentRequest* req,
+                         AddDocumentResponse* resp, ::google::protobuf::Closure* done)
+        {
+            (void) controller;
+            resp->set_sid(req->sid());
+            uint64_t doc_id = 0;
+            doc_index::Index* index = doc_index::Index::Instance();
+            if(index->AddDocument(req->jump_url(), req->title(), req->content(), &doc_id))
+            {
+                resp->set_err_code(0);
+                resp->set_doc_id(doc_id);
+            }
+            else
+            {
+                resp->set_err_code(-1);
+            }
+            done->Run();
+        }
+
+        //在线删除文档
+        void DeleteDocument(::google::protobuf::RpcController* controller, const DeleteDocumentRequest* req,
+                            DeleteDocumentResponse* resp, ::google::protobuf::Closure* done)
+        {
+            (void) controller;
+            resp->set_sid(req->sid());
+            doc_index::Index* index = doc_index::Index::Instance();
+            resp->set_err_code(index->DeleteDocument(req->jump_url()) ? 0 : -1);
+            done->Run();
+        }
+
+        //批量查询，一次 RPC 完成多个查询，省掉每个查询一次的网络往返和线程切换
+        void BatchSearch(::google::protobuf::RpcController* controller, const BatchRequest* req,
+                         BatchResponse* resp, ::google::protobuf::Closure* done)
+        {
+            (void) controller;
+            int64_t received_ms = common::TimeUtil::EstimateReceivedMS(req->sent_ms(), fLI::FLAGS_max_clock_skew_ms);
+            DocSearcher::BatchSearch(*req, resp, batch_pool_, received_ms);
+            done->Run();
+        }
+
+        //重新加载索引文件，新的索引在 reload_pool 的线程中加载，加载完成之后再返回响应，
+        //不占用工作线程，多个重新加载的请求依次执行
+        //只能加载 --index_path 或者 --reload_index_dir 下的文件
+        void ReloadIndex(::google::protobuf::RpcController* controller, const ReloadIndexRequest* req,
+                         ReloadIndexResponse* resp, ::google::protobuf::Closure* done)
+        {
+            (void) controller;
+            resp->set_sid(req->sid());
+            std::string index_path = req->index_path().empty() ? fLS::FLAGS_index_path : req->index_path();
+            if(!ReloadPathAllowed(index_path))
+            {
+                LOG(ERROR) << "ReloadIndex path not allowed, index_path:" << index_path;
+                resp->set_err_code(-2);
+                done->Run();
+                return;
+            }
+            reload_pool_->Submit([index_path, resp, done]
+            {
+                doc_index::Index* index = doc_index::Index::Instance();
+                if(index->Load(index_path))
+                {
+                    resp->set_err_code(0);
+                    resp->set_doc_cnt(index->DocCnt());
+                }
+                else
+                {
+                    resp->set_err_code(-1);
+                }
+                done->Run();
+            });
+        }
+
+        //分片部署时，聚合服务器合并结果之后取最终页面上的文档内容
+        void FetchDocs(::google::protobuf::RpcController* controller, const FetchDocsRequest* req,
+                       Response* resp, ::google::protobuf::Closure* done)
+        {
+            (void) controller;
+            DocSearcher::ThreadLocal()->FetchDocs(*req, resp);
+            done->Run();
+        }
+
+private:
+        //路径中的符号链接和 .. 都解析掉之后再比较，文件不存在时不允许
+        static bool ReloadPathAllowed(const std::string& path)
+        {
+            std::string real_path;
+            if(!RealPath(path, &real_path))
+            {
+                return false;
+            }
+            std::string allowed;
+            if(fLS::FLAGS_reload_index_dir.empty())
+            {
+                return RealPath(fLS::FLAGS_index_path, &allowed) && real_path == allowed;
+            }
+            return RealPath(fLS::FLAGS_reload_index_dir, &allowed)
+                   && real_path.compare(0, allowed.size() + 1, allowed + "/") == 0;
+        }
+
+        static bool RealPath(const std::string& path, std::string* real_path)
+        {
+            char* resolved = realpath(path.c_str(), NULL);
+            if(resolved == NULL)
+            {
+                return false;
+            }
+            real_path->assign(resolved);
+            free(resolved);
+            return true;
+        }
+
+        common::ThreadPool* batch_pool_;
+        common::ThreadPool* reload_pool_;
 };
 
+//进程可以使用的 CPU 核(受 taskset、cgroup 等限制)
+static std::vector<int> AvailableCpus()
+{
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for(int i = 0; i < CPU_SETSIZE; ++i)
+        {
+            if(CPU_ISSET(i, &set))
+            {
+                cpus.push_back(i);
+            }
+        }
+    }
+    return cpus;
+}
+
+//工作线程启动时调用，按照启动的顺序把线程依次绑定到可以使用的各个核上
+static bool BindWorkThread()
+{
+    static const std::vector<int> cpus = AvailableCpus();
+    static std::atomic<size_t> next(0);
+    if(cpus.empty())
+    {
+        return true;
+    }
+    int cpu = cpus[next.fetch_add(1) % cpus.size()];
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if(ret != 0)
+    {
+        //绑定失败不影响服务，只是线程可能在核之间迁移
+        LOG(WARNING) << "pthread_setaffinity_np failed! cpu=" << cpu << " ret=" << ret;
+    }
+    return true;
+}
+
+//索引文件的标识，index_builder 写完之后 rename 过来，文件被替换时 inode 和修改时间都会变
+static bool IndexFileStat(const std::string& path, struct stat* st)
+{
+    return stat(path.c_str(), st) == 0;
+}
+
+//定期检查索引文件，发现被替换之后重新加载
+//加载失败(比如文件不完整)时继续使用原来的索引，文件再次变化之后重试
+static void WatchIndexFile(std::string path, int interval_s)
+{
+    struct stat last;
+    if(!IndexFileStat(path, &last))
+    {
+        memset(&last, 0, sizeof(last));
+    }
+    while(true)
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(interval_s));
+        struct stat st;
+        if(!IndexFileStat(path, &st))
+        {
+            continue;
+        }
+        if(st.st_ino == last.st_ino && st.st_mtime == last.st_mtime && st.st_size == last.st_size)
+        {
+            continue;
+        }
+        last = st;
+        LOG(INFO) << "index file changed, reload index_path:" << path;
+        if(!doc_index::Index::Instance()->Load(path))
+        {
+            LOG(ERROR) << "reload index failed, keep the old index, index_path:" << path;
+        }
+    }
+}
+
 } //end doc_server
 
 
@@ -52,16 +277,39 @@ int main(int argc, char* argv[])
     doc_index::Index* index = doc_index::Index::Instance();
     CHECK(index->Load(fLS::FLAGS_index_path));
     LOG(INFO) << "Index Load Done !";
+    //   索引文件更新之后在后台线程中重新加载，也可以通过 ReloadIndex 请求触发
+    if(fLI::FLAGS_index_watch_interval_s > 0)
+    {
+        std::thread(&doc_server::WatchIndexFile, fLS::FLAGS_index_path, fLI::FLAGS_index_watch_interval_s).detach();
+    }
     //1. 定义一个 RpcServerOptions 对象
     //   这个对象描述了RPC服务器一些相关选项
     //   主要是为了定义线程池中线程的个数
     RpcServerOptions option;
-    option.work_thread_num = 4;
+    option.work_thread_num = fLI::FLAGS_work_thread_num;
+    if(option.work_thread_num <= 0)
+    {
+        option.work_thread_num = std::max<int>(doc_server::AvailableCpus().size(), 1);
+    }
+    if(fLB::FLAGS_bind_cpu)
+    {
+        option.work_thread_init_func = NewPermanentExtClosure(&doc_server::BindWorkThread);
+    }
+    LOG(INFO) << "work_thread_num=" << option.work_thread_num << " bind_cpu=" << fLB::FLAGS_bind_cpu;
     //2. 定义一个RpcServer对象(和ip端口号关联起来)
     RpcServer server(option);
     CHECK(server.Start("0.0.0.0:" + fLS::FLAGS_port));
     //3. 定义一个 DocServerAPIImol，并注册到RpcServer对象中
-    doc_server::DocServerAPIImpl* service_impl = new doc_server::DocServerAPIImpl();
+    //   批量查询主要在单独的线程池中执行，尽量少占用处理普通查询的工作线程
+    int batch_thread_num = fLI::FLAGS_batch_thread_num;
+    if(batch_thread_num <= 0)
+    {
+        batch_thread_num = std::max<int>(doc_server::AvailableCpus().size(), 1);
+    }
+    common::ThreadPool batch_pool(batch_thread_num);
+    //   重新加载索引比较慢，在单独的线程中执行，不占用工作线程
+    common::ThreadPool reload_pool(1);
+    doc_server::DocServerAPIImpl* service_impl = new doc_server::DocServerAPIImpl(&batch_pool, &reload_pool);
     server.RegisterService(service_impl);
     //4. 让 RpcServer 对象开始执行
     server.Run();
@@ -0,0 +1,173 @@
+#include "snippet.h"
+#include <algorithm>
+
+
+namespace doc_server
+{
+
+void SnippetBuilder::Reset(size_t max_size, const std::string& highlight_pre,
+                           const std::string& highlight_post)
+{
+    words_.clear();
+    max_size_ = max_size;
+    highlight_pre_ = highlight_pre;
+    highlight_post_ = highlight_post;
+}
+
+void SnippetBuilder::AddWord(const std::string& word)
+{
+    //同一个词可能在查询中出现多次
+    if(!word.empty() && std::find(words_.begin(), words_.end(), word) == words_.end())
+    {
+        words_.push_back(word);
+    }
+}
+
+bool SnippetBuilder::CmpMatch(const Match& m1, const Match& m2)
+{
+    return m1.beg != m2.beg ? m1.beg < m2.beg : m1.end < m2.end;
+}
+
+bool SnippetBuilder::EqualsLower(const common::StringPiece& token, const std::string& word)
+{
+    if(token.size() != word.size())
+    {
+        return false;
+    }
+    for(size_t i = 0; i < token.size(); ++i)
+    {
+        char c = token[i];
+        if(c >= 'A' && c <= 'Z')
+        {
+            c += 'a' - 'A';
+        }
+        if(c != word[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SnippetBuilder::FindBestWindow(size_t budget, size_t* first, size_t* last)
+{
+    counts_.assign(words_.size(), 0);
+    size_t distinct = 0;
+    size_t best_distinct = 0;
+    *first = 0;
+    *last = 0;
+    //窗口 [i, j) 为第 i 个命中开始，能放进 budget 的所有命中，
+    //i 往后移的时候 j 只会往后移，每个命中只进出窗口一次
+    size_t j = 0;
+    for(size_t i = 0; i < matches_.size(); ++i)
+    {
+        //单个命中比 budget 还长时窗口中只有它自己
+        while(j < matches_.size()
+              && (j == i || (size_t)(matches_[j].end - matches_[i].beg) <= budget))
+        {
+            if(counts_[matches_[j].word]++ == 0)
+            {
+                ++distinct;
+            }
+            ++j;
+        }
+        if(distinct > best_distinct || (distinct == best_distinct && j - i > *last - *first))
+        {
+            best_distinct = distinct;
+            *first = i;
+            *last = j;
+        }
+        if(--counts_[matches_[i].word] == 0)
+        {
+            --distinct;
+        }
+    }
+}
+
+bool SnippetBuilder::Build(const doc_index::DocView& doc, std::string* desc)
+{
+    const common::StringPiece& content = doc.content;
+    if(words_.empty() || doc.content_tokens.empty() || max_size_ <= 3)
+    {
+        return false;
+    }
+    //1. 找出正文中所有的查询词
+    matches_.clear();
+    for(doc_index::ContentTokenIterator it(doc.content_tokens, content.size()); it.Valid(); it.Next())
+    {
+        if(it.beg() < 0 || it.end() <= it.beg() || (size_t)it.end() > content.size())
+        {
+            continue;
+        }
+        common::StringPiece token = content.substr(it.beg(), it.end() - it.beg());
+        for(size_t i = 0; i < words_.size(); ++i)
+        {
+            if(EqualsLower(token, words_[i]))
+            {
+                Match match = {it.beg(), it.end(), (uint32_t)i};
+                matches_.push_back(match);
+                break;
+            }
+        }
+    }
+    if(matches_.empty())
+    {
+        return false;
+    }
+    //CutForSearch 的结果不一定按照位置排好序
+    if(!std::is_sorted(matches_.begin(), matches_.end(), CmpMatch))
+    {
+        std::sort(matches_.begin(), matches_.end(), CmpMatch);
+    }
+
+    //2. 找出包含不同查询词最多的一段，被截断时最后要留3个字节放省略号
+    size_t budget = max_size_ - 3;
+    size_t first = 0;
+    size_t last = 0;
+    FindBestWindow(budget, &first, &last);
+
+    //3. 尽量从这一段所在的句子的开头开始，放不下时从第一个命中的词开始
+    size_t window_beg = matches_[first].beg;
+    size_t window_end = matches_[last - 1].end;
+    size_t beg = doc.SentenceBeg(window_beg);
+    if(window_end - beg > budget)
+    {
+        beg = window_beg;
+    }
+    size_t end = content.size();
+    bool truncated = false;
+    if(beg + max_size_ < content.size())
+    {
+        //截断的位置不能在 UTF-8 字符的中间
+        end = beg + budget;
+        while(end > beg && (content[end] & 0xC0) == 0x80)
+        {
+            --end;
+        }
+        truncated = true;
+    }
+
+    //4. 依次输出命中的词之间的部分和高亮的查询词，重叠的词只高亮前一个
+    size_t pos = beg;
+    for(size_t i = 0; i < matches_.size(); ++i)
+    {
+        const Match& match = matches_[i];
+        if((size_t)match.beg < pos || (size_t)match.end > end)
+        {
+            continue;
+        }
+        common::StringUtil::AppendEscapeHtml(content.substr(pos, match.beg - pos), desc);
+        desc->append(highlight_pre_);
+        common::StringUtil::AppendEscapeHtml(content.substr(match.beg, match.end - match.beg), desc);
+        desc->append(highlight_post_);
+        pos = match.end;
+    }
+    common::StringUtil::AppendEscapeHtml(content.substr(pos, end - pos), desc);
+    if(truncated)
+    {
+        desc->append("...");
+    }
+    return true;
+}
+
+} //end doc_server
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "../../index/cpp/index.h"
+
+
+namespace doc_server
+{
+
+//根据查询词生成文档的描述：在正文中找出长度不超过 max_size 的一段，
+//包含的不同查询词最多(一样多时包含的查询词次数最多，再一样时取最靠前的)，
+//并把其中的查询词用 highlight_pre 和 highlight_post 括起来
+//查询词的位置来自建索引时保存的分词结果，所有命中的词按照位置排好之后用双指针滑动窗口，
+//整个过程对正文的分词结果是线性的
+//对象可以在请求之间复用，中间结果的空间不需要每次都分配
+class SnippetBuilder
+{
+public:
+    SnippetBuilder()
+        : max_size_(0)
+    {}
+
+    //开始一个新的请求，清空查询词
+    void Reset(size_t max_size, const std::string& highlight_pre, const std::string& highlight_post);
+
+    //加入一个去掉暂停词之后的查询词(小写)，重复的词只保留一个
+    void AddWord(const std::string& word);
+
+    //生成描述(已经做了 HTML 转义)追加到 desc 中
+    //文档没有保存分词结果，或者正文中没有查询词时返回 false，desc 不变
+    bool Build(const doc_index::DocView& doc, std::string* desc);
+
+private:
+    //正文中命中的一个查询词
+    struct Match
+    {
+        int32_t beg;
+        int32_t end;
+        uint32_t word; //words_ 中的下标
+    };
+
+    static bool CmpMatch(const Match& m1, const Match& m2);
+
+    //正文中的一个词是否和查询词相同(正文不区分大小写)
+    static bool EqualsLower(const common::StringPiece& token, const std::string& word);
+
+    //找出包含不同查询词最多的一段，返回 [*first, *last) 为这一段中的命中
+    void FindBestWindow(size_t budget, size_t* first, size_t* last);
+
+    std::vector<std::string> words_;
+    size_t max_size_;
+    std::string highlight_pre_;
+    std::string highlight_post_;
+    std::vector<Match> matches_;
+    std::vector<uint32_t> counts_; //窗口内每个查询词命中的次数
+};
+
+} //end doc_server
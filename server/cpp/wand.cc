@@ -0,0 +1,315 @@
+#include "wand.h"
+#include <algorithm>
+#include <limits>
+
+
+namespace doc_server
+{
+
+static const uint32_t kMaxDocId = std::numeric_limits<uint32_t>::max();
+
+TermCursor::TermCursor(const doc_index::PostingList& posting_list, const doc_index::Bm25Scorer* scorer,
+                       const doc_index::PositionList& positions)
+{
+    Reset(posting_list, scorer, positions);
+}
+
+TermCursor::TermCursor(const doc_index::InvertedList* inverted_list, const doc_index::Bm25Scorer* scorer)
+{
+    Reset(inverted_list, scorer);
+}
+
+void TermCursor::Reset(const doc_index::PostingList& posting_list, const doc_index::Bm25Scorer* scorer,
+                       const doc_index::PositionList& positions)
+{
+    posting_list_ = posting_list;
+    position_list_ = positions;
+    if(it_)
+    {
+        it_->Reset(posting_list);
+    }
+    else
+    {
+        it_.reset(new doc_index::PostingIterator(posting_list));
+    }
+    realtime_list_ = NULL;
+    pos_ = 0;
+    scorer_ = scorer;
+    max_score_ = scorer->MaxScore(posting_list.max_title_tf(), posting_list.max_content_tf());
+    block_last_doc_id_ = 0;
+}
+
+void TermCursor::Reset(const doc_index::InvertedList* inverted_list, const doc_index::Bm25Scorer* scorer)
+{
+    realtime_list_ = inverted_list;
+    scorer_ = scorer;
+    max_score_ = 0;
+    block_last_doc_id_ = 0;
+    //实时段的拉链很短，整个拉链当作一个块，直接算出每个文档的得分
+    for(pos_ = 0; pos_ < inverted_list->size(); ++pos_)
+    {
+        max_score_ = std::max(max_score_, score());
+    }
+    pos_ = 0;
+}
+
+TermCursor* CursorPool::New(const doc_index::PostingList& posting_list, const doc_index::Bm25Scorer* scorer,
+                            const doc_index::PositionList& positions)
+{
+    if(used_ == cursors_.size())
+    {
+        cursors_.push_back(std::unique_ptr<TermCursor>(new TermCursor(posting_list, scorer, positions)));
+    }
+    else
+    {
+        cursors_[used_]->Reset(posting_list, scorer, positions);
+    }
+    return cursors_[used_++].get();
+}
+
+TermCursor* CursorPool::New(const doc_index::InvertedList* inverted_list, const doc_index::Bm25Scorer* scorer)
+{
+    if(used_ == cursors_.size())
+    {
+        cursors_.push_back(std::unique_ptr<TermCursor>(new TermCursor(inverted_list, scorer)));
+    }
+    else
+    {
+        cursors_[used_]->Reset(inverted_list, scorer);
+    }
+    return cursors_[used_++].get();
+}
+
+int32_t TermCursor::score() const
+{
+    const doc_index::DocLength& length = doc_index::Index::Instance()->GetDocLength(doc_id());
+    if(realtime_list_ == NULL)
+    {
+        return scorer_->Score(it_->title_tf(), it_->content_tf(), length);
+    }
+    return scorer_->Score(realtime_list_->title_tf[pos_], realtime_list_->content_tf[pos_], length);
+}
+
+bool TermCursor::positions(std::vector<uint32_t>* positions) const
+{
+    if(realtime_list_ == NULL)
+    {
+        if(position_list_.empty())
+        {
+            return false;
+        }
+        position_list_.Get(it_->ordinal(), positions);
+        return true;
+    }
+    if(!realtime_list_->has_positions())
+    {
+        return false;
+    }
+    positions->assign(realtime_list_->positions.begin() + realtime_list_->position_beg(pos_),
+                      realtime_list_->positions.begin() + realtime_list_->position_ends[pos_]);
+    return true;
+}
+
+void TermCursor::Next()
+{
+    if(realtime_list_ == NULL)
+    {
+        it_->Next();
+        return;
+    }
+    ++pos_;
+}
+
+void TermCursor::SkipTo(uint64_t doc_id)
+{
+    if(realtime_list_ != NULL)
+    {
+        if(doc_id > kMaxDocId)
+        {
+            pos_ = realtime_list_->size();
+            return;
+        }
+        pos_ = std::lower_bound(realtime_list_->doc_ids.begin() + pos_, realtime_list_->doc_ids.end(),
+                                (uint32_t)doc_id) - realtime_list_->doc_ids.begin();
+        return;
+    }
+    if(doc_id > kMaxDocId)
+    {
+        //跳到末尾
+        it_->SkipTo(kMaxDocId);
+        if(it_->Valid())
+        {
+            it_->Next();
+        }
+        return;
+    }
+    it_->SkipTo(doc_id);
+}
+
+int32_t TermCursor::ShallowBlockMax(uint32_t doc_id)
+{
+    if(realtime_list_ != NULL)
+    {
+        if(realtime_list_->empty() || realtime_list_->doc_ids.back() < doc_id)
+        {
+            block_last_doc_id_ = kMaxDocId;
+            return 0;
+        }
+        block_last_doc_id_ = realtime_list_->doc_ids.back();
+        return max_score_;
+    }
+    size_t block = posting_list_.FindBlock(doc_id, it_->current_block());
+    if(block >= posting_list_.block_cnt())
+    {
+        block_last_doc_id_ = kMaxDocId;
+        return 0;
+    }
+    const doc_index::PostingBlock& cur = posting_list_.block(block);
+    block_last_doc_id_ = cur.last_doc_id;
+    return scorer_->MaxScore(cur.max_title_tf, cur.max_content_tf);
+}
+
+void TopKCollector::Take(std::vector<ScoredDoc>* results)
+{
+    results->resize(heap_.size());
+    for(size_t i = heap_.size(); i > 0; --i)
+    {
+        (*results)[i - 1] = heap_.top();
+        heap_.pop();
+    }
+}
+
+bool ExcludeFilter::Match(uint32_t doc_id)
+{
+    for(TermCursor* cursor : cursors_)
+    {
+        cursor->SkipTo(doc_id);
+        if(cursor->Valid() && cursor->doc_id() == doc_id)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//去掉已经遍历完的游标，剩下的按照当前的文档id升序排列
+void WandRetriever::SortCursors()
+{
+    cursors_.erase(std::remove_if(cursors_.begin(), cursors_.end(),
+                                  [](const TermCursor* cursor)
+                                  {
+                                      return !cursor->Valid();
+                                  }),
+                   cursors_.end());
+    std::sort(cursors_.begin(), cursors_.end(),
+              [](const TermCursor* c1, const TermCursor* c2)
+              {
+                  return c1->doc_id() < c2->doc_id();
+              });
+}
+
+void WandRetriever::Search(size_t k, std::vector<ScoredDoc>* results, Deadline* deadline)
+{
+    results->clear();
+    if(k == 0)
+    {
+        return;
+    }
+    doc_index::Index* index = doc_index::Index::Instance();
+    //文档是按照id升序处理的
+    TopKCollector top_k(k);
+
+    while(true)
+    {
+        SortCursors();
+        if(cursors_.empty() || (deadline != NULL && deadline->Check()))
+        {
+            break;
+        }
+        int64_t threshold = top_k.threshold();
+
+        //1. 找 pivot，按照文档id的顺序累加拉链的得分上限，第一个超过 threshold 的位置
+        int64_t upper_bound = 0;
+        size_t pivot = cursors_.size();
+        for(size_t i = 0; i < cursors_.size(); ++i)
+        {
+            upper_bound += cursors_[i]->max_score();
+            if(upper_bound > threshold)
+            {
+                pivot = i;
+                break;
+            }
+        }
+        if(pivot == cursors_.size())
+        {
+            //剩下的文档都不可能进入前 k 名
+            break;
+        }
+        uint32_t pivot_doc_id = cursors_[pivot]->doc_id();
+        //和 pivot 文档id相同的拉链也要算进来
+        while(pivot + 1 < cursors_.size() && cursors_[pivot + 1]->doc_id() == pivot_doc_id)
+        {
+            ++pivot;
+        }
+
+        //2. 用 pivot 文档所在的块的得分上限再判断一次
+        int64_t block_upper_bound = 0;
+        uint64_t next_doc_id = (uint64_t)kMaxDocId + 1;
+        for(size_t i = 0; i <= pivot; ++i)
+        {
+            block_upper_bound += cursors_[i]->ShallowBlockMax(pivot_doc_id);
+            next_doc_id = std::min(next_doc_id, cursors_[i]->block_last_doc_id() + 1);
+        }
+
+        if(block_upper_bound <= threshold)
+        {
+            //3. [pivot_doc_id, next_doc_id) 范围内的文档都在这些块中，上限都不超过 threshold，
+            //   pivot 之后的拉链的文档id都 >= next_doc_id，整段跳过
+            if(pivot + 1 < cursors_.size())
+            {
+                next_doc_id = std::min<uint64_t>(next_doc_id, cursors_[pivot + 1]->doc_id());
+            }
+            for(size_t i = 0; i <= pivot; ++i)
+            {
+                cursors_[i]->SkipTo(next_doc_id);
+            }
+            continue;
+        }
+
+        if(cursors_[0]->doc_id() != pivot_doc_id)
+        {
+            //4. pivot 之前的文档不可能进入前 k 名，把前面的游标都跳到 pivot
+            for(size_t i = 0; i < pivot && cursors_[i]->doc_id() < pivot_doc_id; ++i)
+            {
+                cursors_[i]->SkipTo(pivot_doc_id);
+            }
+            continue;
+        }
+
+        //5. 所有文档id <= pivot 的游标都在 pivot 上，计算 pivot 文档的完整得分
+        ScoredDoc doc;
+        doc.doc_id = pivot_doc_id;
+        doc.score = 0;
+        doc.first_pos = -1;
+        int32_t best_score = -1;
+        for(size_t i = 0; i < cursors_.size() && cursors_[i]->doc_id() == pivot_doc_id; ++i)
+        {
+            int32_t score = cursors_[i]->score();
+            doc.score += score;
+            if(score > best_score)
+            {
+                best_score = score;
+                doc.first_pos = cursors_[i]->first_pos();
+            }
+            cursors_[i]->Next();
+        }
+        if(doc.score > threshold && !index->IsDeleted(doc.doc_id) && !exclude_.Match(doc.doc_id))
+        {
+            top_k.Push(doc);
+        }
+    }
+
+    top_k.Take(results);
+}
+
+} //end doc_server
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <queue>
+#include <stdint.h>
+#include "../../index/cpp/index.h"
+
+
+namespace doc_server
+{
+
+//一个查询词的倒排拉链的游标，按照文档id升序遍历
+//索引文件中的压缩拉链和实时段中的拉链用同样的接口访问
+class TermCursor
+{
+public:
+    //索引文件中的压缩拉链，scorer 为这个查询词的打分器，positions 为拉链的位置索引(可以为空)
+    TermCursor(const doc_index::PostingList& posting_list, const doc_index::Bm25Scorer* scorer,
+               const doc_index::PositionList& positions = doc_index::PositionList());
+    //实时段中的拉链(拷贝出来的)
+    TermCursor(const doc_index::InvertedList* inverted_list, const doc_index::Bm25Scorer* scorer);
+
+    //重新指向另一个拉链，参数和构造函数一样，解压缓冲区可以复用
+    void Reset(const doc_index::PostingList& posting_list, const doc_index::Bm25Scorer* scorer,
+               const doc_index::PositionList& positions = doc_index::PositionList());
+    void Reset(const doc_index::InvertedList* inverted_list, const doc_index::Bm25Scorer* scorer);
+
+    bool Valid() const
+    {
+        return realtime_list_ == NULL ? it_->Valid() : pos_ < realtime_list_->size();
+    }
+
+    uint32_t doc_id() const
+    {
+        return realtime_list_ == NULL ? it_->doc_id() : realtime_list_->doc_ids[pos_];
+    }
+
+    //当前文档的得分
+    int32_t score() const;
+
+    int32_t first_pos() const
+    {
+        return realtime_list_ == NULL ? it_->first_pos() : realtime_list_->first_pos[pos_];
+    }
+
+    //当前文档中查询词出现的位置，没有位置索引时返回 false
+    bool positions(std::vector<uint32_t>* positions) const;
+
+    //拉链中的文档数
+    uint32_t size() const
+    {
+        return realtime_list_ == NULL ? posting_list_.size() : realtime_list_->size();
+    }
+
+    void Next();
+
+    //跳到第一个文档id >= doc_id 的位置，超出32位的 doc_id 表示跳到末尾
+    void SkipTo(uint64_t doc_id);
+
+    //整个拉链中文档得分的上限
+    int32_t max_score() const
+    {
+        return max_score_;
+    }
+
+    //只根据块头找到包含 doc_id 的块(第一个 last_doc_id >= doc_id 的块)，不解压，
+    //返回这个块中文档得分的上限，块的最后一个文档id通过 block_last_doc_id 获取，
+    //doc_id 之后没有文档时返回0，block_last_doc_id 为 UINT32_MAX
+    int32_t ShallowBlockMax(uint32_t doc_id);
+
+    uint64_t block_last_doc_id() const
+    {
+        return block_last_doc_id_;
+    }
+
+private:
+    doc_index::PostingList posting_list_;
+    doc_index::PositionList position_list_;
+    std::unique_ptr<doc_index::PostingIterator> it_;
+    const doc_index::InvertedList* realtime_list_;
+    size_t pos_;
+    const doc_index::Bm25Scorer* scorer_;
+    int32_t max_score_;
+    uint64_t block_last_doc_id_;
+};
+
+//游标的对象池，游标(主要是其中的解压缓冲区)在请求之间复用，不需要每次都分配
+//Clear 之后之前拿到的游标都不能再用了
+class CursorPool
+{
+public:
+    CursorPool()
+        : used_(0)
+    {}
+
+    TermCursor* New(const doc_index::PostingList& posting_list, const doc_index::Bm25Scorer* scorer,
+                    const doc_index::PositionList& positions = doc_index::PositionList());
+
+    TermCursor* New(const doc_index::InvertedList* inverted_list, const doc_index::Bm25Scorer* scorer);
+
+    void Clear()
+    {
+        used_ = 0;
+    }
+
+private:
+    std::vector<std::unique_ptr<TermCursor>> cursors_;
+    size_t used_; //前 used_ 个游标正在使用
+};
+
+//请求的截止时间，检索的循环中定期检查，时间用完之后提前结束，返回已经找到的结果
+//累计处理了 kCheckInterval 个文档才取一次当前时间，取时间的开销可以忽略
+class Deadline
+{
+public:
+    Deadline()
+        : deadline_ms_(0)
+        , cnt_(0)
+        , expired_(false)
+    {}
+
+    //deadline_ms 为毫秒时间戳(TimeUtil::TimeStampMS)，0 表示没有截止时间
+    void Reset(int64_t deadline_ms)
+    {
+        deadline_ms_ = deadline_ms;
+        cnt_ = 0;
+        expired_ = false;
+    }
+
+    //循环中每一轮调用一次，doc_cnt 为这一轮处理的文档数
+    bool Check(uint32_t doc_cnt = 1)
+    {
+        if(deadline_ms_ == 0 || expired_)
+        {
+            return expired_;
+        }
+        cnt_ += doc_cnt;
+        if(cnt_ < kCheckInterval)
+        {
+            return false;
+        }
+        cnt_ = 0;
+        return Now();
+    }
+
+    //马上取当前时间检查
+    bool Now()
+    {
+        if(deadline_ms_ != 0 && !expired_)
+        {
+            expired_ = common::TimeUtil::TimeStampMS() >= deadline_ms_;
+        }
+        return expired_;
+    }
+
+    //是否已经因为时间用完提前结束过
+    bool expired() const
+    {
+        return expired_;
+    }
+
+    int64_t deadline_ms() const
+    {
+        return deadline_ms_;
+    }
+
+private:
+    static const uint32_t kCheckInterval = 256;
+
+    int64_t deadline_ms_;
+    uint32_t cnt_;
+    bool expired_;
+};
+
+//top-k 检索的结果
+struct ScoredDoc
+{
+    int64_t score;
+    uint32_t doc_id;
+    int32_t first_pos; //得分最高的查询词在正文中第一次出现的位置
+};
+
+//保留得分最高的 k 个文档，得分相同时文档id小的排在前面
+class TopKCollector
+{
+public:
+    explicit TopKCollector(size_t k)
+        : k_(k)
+    {}
+
+    //当前第 k 名的得分，得分不超过它的文档不可能进入前 k 名，
+    //前 k 名还没有凑满时为 -1，任何文档都可以进入
+    //文档需要按照id升序加入，得分相同时先加入的(id小的)排在前面
+    int64_t threshold() const
+    {
+        return heap_.size() < k_ ? -1 : heap_.top().score;
+    }
+
+    void Push(const ScoredDoc& doc)
+    {
+        if(k_ == 0 || doc.score <= threshold())
+        {
+            return;
+        }
+        heap_.push(doc);
+        if(heap_.size() > k_)
+        {
+            heap_.pop();
+        }
+    }
+
+    //按照得分降序放到 results 中
+    void Take(std::vector<ScoredDoc>* results);
+
+private:
+    struct Better
+    {
+        bool operator()(const ScoredDoc& d1, const ScoredDoc& d2) const
+        {
+            return d1.score > d2.score || (d1.score == d2.score && d1.doc_id < d2.doc_id);
+        }
+    };
+
+    size_t k_;
+    //堆顶是当前前 k 名中最差的文档
+    std::priority_queue<ScoredDoc, std::vector<ScoredDoc>, Better> heap_;
+};
+
+//查询中需要排除的词(NOT)，命中任意一个排除游标的文档都要去掉
+//需要按照文档id升序检查，每个游标只往后跳
+class ExcludeFilter
+{
+public:
+    void AddCursor(TermCursor* cursor)
+    {
+        cursors_.push_back(cursor);
+    }
+
+    bool empty() const
+    {
+        return cursors_.empty();
+    }
+
+    bool Match(uint32_t doc_id);
+
+private:
+    std::vector<TermCursor*> cursors_;
+};
+
+//Block-Max WAND 算法的 top-k 检索，文档的得分为所有命中的查询词的得分之和
+//所有游标按照当前的文档id排序，从前往后累加每个拉链的得分上限，
+//第一个累加和超过当前第 k 名得分的位置对应的文档叫做 pivot，
+//比 pivot 小的文档不可能进入前 k 名，可以直接跳过。
+//再用 pivot 所在的块的得分上限做一次更精确的判断，块的上限也不够时，
+//整段跳过这些块，不需要解压。
+//这样需要完整计算得分的文档数和 k 相关，而不是和拉链的总长度相关
+class WandRetriever
+{
+public:
+    void AddCursor(TermCursor* cursor)
+    {
+        cursors_.push_back(cursor);
+    }
+
+    //命中排除游标的文档不参与排序
+    void AddExcludeCursor(TermCursor* cursor)
+    {
+        exclude_.AddCursor(cursor);
+    }
+
+    //检索得分最高的 k 个文档，按照得分降序(得分相同时文档id升序)放到 results 中
+    //已经删除的文档不参与排序
+    //deadline 不为 NULL 时，时间用完之后提前结束，results 为已经检查过的文档中的前 k 个
+    void Search(size_t k, std::vector<ScoredDoc>* results, Deadline* deadline = NULL);
+
+private:
+    void SortCursors();
+
+    std::vector<TermCursor*> cursors_;
+    ExcludeFilter exclude_;
+};
+
+} //end doc_server